@@ -1,7 +1,8 @@
-#version 400 core
+#version 420 core
 
 #define MAX_LIGHTS 10
-#define MAX_TEXTURES 16
+#define MAX_TEXTURE_ARRAYS 16
+#define MAX_TEXTURE_SLOTS 1024
 #define WHITE_V3 vec3(1, 1, 1)
 
 in vec2 out_texture_coords;
@@ -12,20 +13,38 @@ flat in int out_tex_id;
 
 out vec4 fragColor;
 
-uniform sampler2D u_textures[MAX_TEXTURES];
+layout (binding = 0) uniform sampler2DArray u_texture_arrays[MAX_TEXTURE_ARRAYS];
+// Texture array of every slot of the draw, so the sampler is indexed by a uniform value
+uniform int u_texture_array;
 
-uniform vec3 u_ambientColor;
-uniform float u_ambientStrength;
+struct Light
+{
+  vec3 position;
+  float strength;
+  vec3 color;
+  float specular_strength;
+  float specular_shininess;
+};
 
-uniform vec3 u_lightPos[MAX_LIGHTS];
-uniform vec3 u_lightColor[MAX_LIGHTS];
-uniform float u_lightStrength[MAX_LIGHTS];
-uniform float u_specularStrenght[MAX_LIGHTS];
-uniform float u_specularShininess[MAX_LIGHTS];
+layout (std140, binding = 0) uniform Camera
+{
+  mat4 u_VP;
+  vec3 u_viewPos;
+};
 
-uniform int u_lights_count;
+layout (std140, binding = 1) uniform Lights
+{
+  Light u_lights[MAX_LIGHTS];
+  vec3 u_ambientColor;
+  float u_ambientStrength;
+  int u_lights_count;
+};
 
-uniform vec3 u_viewPos;
+// Texture array and layer of each texture slot, packed as (array << 16 | layer)
+layout (std140, binding = 2) uniform TextureLayers
+{
+  ivec4 u_texture_layers[MAX_TEXTURE_SLOTS / 4];
+};
 
 vec3 get_ambient()
 {
@@ -41,8 +60,8 @@ vec3 get_diffuse(inout vec3 frag_normal, inout vec3 light_directions[MAX_LIGHTS]
   {
     float cosine = dot(frag_normal, light_directions[i]);// -1 to 1
     float diff = max(0, cosine);
-    float dist_inv = 1 / distance(out_frag_pos, u_lightPos[i]);
-    diffuses = diffuses + (dist_inv * u_lightStrength[i] * diff * u_lightColor[i]);
+    float dist_inv = 1 / distance(out_frag_pos, u_lights[i].position);
+    diffuses = diffuses + (dist_inv * u_lights[i].strength * diff * u_lights[i].color);
   }
   return diffuses;
 }
@@ -54,8 +73,8 @@ vec3 get_specular(inout vec3 frag_normal, inout vec3 light_directions[MAX_LIGHTS
   for (int i = 0; i < u_lights_count; i++)
   {
     vec3 reflect_dir = reflect(-light_directions[i], frag_normal);
-    float spec = pow(max(dot(view_direction, reflect_dir), 0.0), u_specularShininess[i]);
-    speculars = speculars + u_specularStrenght[i] * spec * u_lightColor[i];
+    float spec = pow(max(dot(view_direction, reflect_dir), 0.0), u_lights[i].specular_shininess);
+    speculars = speculars + u_lights[i].specular_strength * spec * u_lights[i].color;
   }
   return speculars;
 }
@@ -69,10 +88,12 @@ void main()
   vec3 light_directions[MAX_LIGHTS];
   for (int i = 0; i < u_lights_count; i++)
   {
-    light_directions[i] = normalize(u_lightPos[i] - out_frag_pos);
+    light_directions[i] = normalize(u_lights[i].position - out_frag_pos);
   }
 
-  vec4 texture = texture2D(u_textures[out_tex_id], out_texture_coords);
+  int location = u_texture_layers[out_tex_id / 4][out_tex_id % 4];
+  vec3 texture_coords = vec3(out_texture_coords, location & 0xFFFF);
+  vec4 texture = texture(u_texture_arrays[u_texture_array], texture_coords);
   vec3 object_color = out_color.rgb * texture.rgb;
   vec3 result = (get_ambient() + get_diffuse(frag_normal, light_directions) + get_specular(frag_normal, light_directions)) * object_color;
   fragColor = vec4(result, out_color.a);
@@ -1,4 +1,4 @@
-#version 400 core
+#version 420 core
 
 layout (location = 0) in vec3 in_position;
 layout (location = 1) in vec2 in_texture_coord;
@@ -12,7 +12,11 @@ out vec3 out_normal;
 out vec3 out_frag_pos;
 flat out int out_tex_id;
 
-uniform mat4 u_VP;
+layout (std140, binding = 0) uniform Camera
+{
+  mat4 u_VP;
+  vec3 u_viewPos;
+};
 
 void main()
 {
@@ -0,0 +1,34 @@
+#version 420 core
+
+layout (location = 0) in vec3 in_position;
+layout (location = 1) in vec2 in_texture_coord;
+layout (location = 2) in vec4 in_color;
+layout (location = 3) in vec3 in_normal;
+layout (location = 4) in int in_tex_id;
+layout (location = 5) in mat4 in_model;
+layout (location = 9) in mat3 in_normal_matrix;
+layout (location = 12) in vec4 in_instance_color;
+layout (location = 13) in int in_instance_tex_id;
+
+out vec2 out_texture_coords;
+out vec4 out_color;
+out vec3 out_normal;
+out vec3 out_frag_pos;
+flat out int out_tex_id;
+
+layout (std140, binding = 0) uniform Camera
+{
+  mat4 u_VP;
+  vec3 u_viewPos;
+};
+
+void main()
+{
+  vec4 world_position = in_model * vec4(in_position, 1.0);
+  gl_Position = u_VP * world_position;
+  out_frag_pos = world_position.xyz;
+  out_texture_coords = in_texture_coord;
+  out_color = in_instance_color;
+  out_normal = in_normal_matrix * in_normal;
+  out_tex_id = in_instance_tex_id;
+}
@@ -0,0 +1,31 @@
+#version 420 core
+
+#define MAX_TEXTURE_ARRAYS 16
+#define MAX_TEXTURE_SLOTS 1024
+
+in vec2 out_texture_coords;
+in vec4 out_color;
+in vec3 out_normal;
+in vec3 out_frag_pos;
+flat in int out_tex_id;
+
+out vec4 fragColor;
+
+layout (binding = 0) uniform sampler2DArray u_texture_arrays[MAX_TEXTURE_ARRAYS];
+// Texture array of every slot of the draw, so the sampler is indexed by a uniform value
+uniform int u_texture_array;
+
+// Texture array and layer of each texture slot, packed as (array << 16 | layer)
+layout (std140, binding = 2) uniform TextureLayers
+{
+  ivec4 u_texture_layers[MAX_TEXTURE_SLOTS / 4];
+};
+
+// Objects keep their own color, whatever the lights of the scene
+void main()
+{
+  int location = u_texture_layers[out_tex_id / 4][out_tex_id % 4];
+  vec3 texture_coords = vec3(out_texture_coords, location & 0xFFFF);
+  vec4 texture = texture(u_texture_arrays[u_texture_array], texture_coords);
+  fragColor = vec4(out_color.rgb * texture.rgb, out_color.a);
+}
@@ -14,6 +14,16 @@ if (DEFINED COVERAGE_ENABLED)
   target_compile_definitions(GrapengineCompileOptions INTERFACE GE_COVERAGE_ENABLED)
 endif()
 
+# SSE2 is the baseline for x64 builds, AVX2 kernels are opt-in
+if (DEFINED AVX2_ENABLED)
+  message(STATUS "GRAPENGINE: Enabling AVX2")
+  if (CMAKE_CXX_COMPILER_ID STREQUAL "MSVC" OR CMAKE_CXX_COMPILER_FRONTEND_VARIANT STREQUAL "MSVC")
+    target_compile_options(GrapengineCompileOptions INTERFACE /arch:AVX2)
+  else ()
+    target_compile_options(GrapengineCompileOptions INTERFACE -mavx2)
+  endif ()
+endif()
+
 message(STATUS "GRAPENGINE: Setting up compiler flags for ${CMAKE_CXX_COMPILER_ID} ${CMAKE_CXX_COMPILER_VERSION} (${CMAKE_CXX_COMPILER_FRONTEND_VARIANT})")
 if (CMAKE_CXX_COMPILER_ID STREQUAL "MSVC")
   target_compile_definitions(GrapengineCompileOptions INTERFACE GE_MSVC_COMPILER)
@@ -94,6 +94,8 @@ void Application::Run()
       std::ranges::for_each(m_layers, [&](auto&& l) { l->OnImGuiUpdate(step); });
       m_imgui_layer->End();
       GE_PROFILE_FRAME_END(IMGUI_FRAME);
+
+      Renderer::EndFrame();
     }
 
     m_window->OnUpdate();
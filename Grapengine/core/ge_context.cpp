@@ -1,5 +1,8 @@
 #include "ge_context.hpp"
 
+#include "renderer/ge_gl_state_cache.hpp"
+#include "renderer/ge_render_target_pool.hpp"
+
 #include <GLFW/glfw3.h>
 #include <glad/glad.h>
 
@@ -18,6 +21,9 @@ void Context::Init()
   GE_INFO("GLAD initialization: {}", version)
   GE_ASSERT_OR_RETURN_VOID(version != 0, "Failed to initialize OpenGL context");
 
+  // A new context starts with the default state, whatever the cache kept from a previous one
+  GLStateCache::Get().Invalidate();
+
   // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
   GE_INFO("OpenGL INFO BEGIN-----------------------------------")
   GE_INFO("OpenGL Vendor: {}", reinterpret_cast<const char*>(glGetString(GL_VENDOR)))
@@ -31,6 +37,13 @@ void Context::Init()
   // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
 }
 
+void Context::Shutdown()
+{
+  glfwMakeContextCurrent(m_window);
+  RenderTargetPool::Get().Clear();
+  GLStateCache::Get().Invalidate();
+}
+
 void Context::SwapBuffers()
 {
   glfwSwapBuffers(m_window);
@@ -13,6 +13,11 @@ namespace GE
 
     void Init();
 
+    /**
+     * Delete the objects cached by the engine for the context, before it is destroyed
+     */
+    void Shutdown();
+
     void SwapBuffers();
 
   private:
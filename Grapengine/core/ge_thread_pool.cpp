@@ -0,0 +1,163 @@
+#include "core/ge_thread_pool.hpp"
+
+#include "profiling/ge_profiler.hpp"
+
+using namespace GE;
+
+ThreadPool& ThreadPool::Get()
+{
+  static ThreadPool pool{ std::max(std::thread::hardware_concurrency(), 2u) - 1 };
+  return pool;
+}
+
+ThreadPool::ThreadPool(u32 workersCount)
+{
+  // The last queue is fed by threads that are not workers
+  for (u32 i = 0; i <= workersCount; i++)
+    m_queues.emplace_back(MakeScope<Queue>());
+
+  for (u32 i = 0; i < workersCount; i++)
+    m_workers.emplace_back([this, i] { WorkerLoop(i); });
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    const std::scoped_lock lock{ m_wake_mutex };
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  for (std::thread& worker : m_workers)
+    worker.join();
+}
+
+u32 ThreadPool::GetWorkersCount() const
+{
+  return static_cast<u32>(m_workers.size());
+}
+
+void ThreadPool::ParallelFor(u64 count, u64 grain, const std::function<void(u64, u64)>& fun)
+{
+  GE_PROFILE;
+  grain = std::max<u64>(grain, 1);
+  if (count <= grain || m_workers.empty())
+  {
+    fun(0, count);
+    return;
+  }
+
+  const u64 chunks = (count + grain - 1) / grain;
+  std::atomic<u64> remaining = chunks;
+  for (u64 chunk = 0; chunk < chunks; chunk++)
+  {
+    const u64 begin = chunk * grain;
+    const u64 end = std::min(begin + grain, count);
+    Push(static_cast<u32>(chunk % m_workers.size()),
+         [&fun, &remaining, begin, end]
+         {
+           fun(begin, end);
+           remaining.fetch_sub(1, std::memory_order_release);
+         });
+  }
+
+  // Help the workers instead of blocking
+  const auto own_queue = static_cast<u32>(m_workers.size());
+  while (remaining.load(std::memory_order_acquire) > 0)
+  {
+    if (!RunTask(own_queue))
+      std::this_thread::yield();
+  }
+}
+
+void ThreadPool::Submit(std::function<void()> task)
+{
+  if (m_workers.empty())
+  {
+    task();
+    return;
+  }
+
+  {
+    const std::scoped_lock lock{ m_background.mutex };
+    m_background.tasks.push_back(std::move(task));
+  }
+  {
+    const std::scoped_lock lock{ m_wake_mutex };
+    m_pending_tasks++;
+  }
+  m_wake.notify_one();
+}
+
+void ThreadPool::Push(u32 queue, Task&& task)
+{
+  {
+    const std::scoped_lock lock{ m_queues[queue]->mutex };
+    m_queues[queue]->tasks.push_back(std::move(task));
+  }
+  {
+    const std::scoped_lock lock{ m_wake_mutex };
+    m_pending_tasks++;
+  }
+  m_wake.notify_one();
+}
+
+bool ThreadPool::RunTask(u32 queue)
+{
+  Task task;
+  for (u64 i = 0; i < m_queues.size() && !task; i++)
+  {
+    // Own tasks are taken from the back, stolen ones from the front
+    Queue& q = *m_queues[(queue + i) % m_queues.size()];
+    const std::scoped_lock lock{ q.mutex };
+    if (q.tasks.empty())
+      continue;
+
+    if (i == 0)
+    {
+      task = std::move(q.tasks.back());
+      q.tasks.pop_back();
+    }
+    else
+    {
+      task = std::move(q.tasks.front());
+      q.tasks.pop_front();
+    }
+  }
+
+  if (!task)
+    return false;
+
+  m_pending_tasks--;
+  task();
+  return true;
+}
+
+bool ThreadPool::RunBackgroundTask()
+{
+  Task task;
+  {
+    const std::scoped_lock lock{ m_background.mutex };
+    if (m_background.tasks.empty())
+      return false;
+    task = std::move(m_background.tasks.front());
+    m_background.tasks.pop_front();
+  }
+
+  m_pending_tasks--;
+  task();
+  return true;
+}
+
+void ThreadPool::WorkerLoop(u32 queue)
+{
+  while (true)
+  {
+    if (RunTask(queue) || RunBackgroundTask())
+      continue;
+
+    std::unique_lock lock{ m_wake_mutex };
+    m_wake.wait(lock, [this] { return m_stop || m_pending_tasks > 0; });
+    if (m_stop)
+      return;
+  }
+}
@@ -0,0 +1,68 @@
+#ifndef GRAPENGINE_GE_THREAD_POOL_HPP
+#define GRAPENGINE_GE_THREAD_POOL_HPP
+
+#include "ge_type_aliases.hpp"
+
+namespace GE
+{
+  /**
+   * Pool of worker threads where each worker owns a queue of tasks and steals from the others
+   * when its own queue is empty.
+   */
+  class ThreadPool
+  {
+  public:
+    /**
+     * Pool shared by the engine, with one worker for each hardware thread but the caller one
+     */
+    static ThreadPool& Get();
+
+    explicit ThreadPool(u32 workersCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    [[nodiscard]] u32 GetWorkersCount() const;
+
+    /**
+     * Split the range [0, count) in chunks of grain elements and run them in parallel.
+     * The calling thread also runs chunks and returns only when all of them are done.
+     * @param count number of elements
+     * @param grain maximum number of elements in each chunk
+     * @param fun function called with the range [begin, end) of each chunk
+     */
+    void ParallelFor(u64 count, u64 grain, const std::function<void(u64, u64)>& fun);
+
+    /**
+     * Run a long task on a worker without waiting for it, or right away when there are no
+     * workers. Background tasks are only taken when no other task is queued, and never by the
+     * threads helping in ParallelFor, so they do not delay the frame.
+     */
+    void Submit(std::function<void()> task);
+
+  private:
+    using Task = std::function<void()>;
+
+    struct Queue
+    {
+      std::mutex mutex;
+      std::deque<Task> tasks;
+    };
+
+    void Push(u32 queue, Task&& task);
+    [[nodiscard]] bool RunTask(u32 queue);
+    [[nodiscard]] bool RunBackgroundTask();
+    void WorkerLoop(u32 queue);
+
+    std::vector<Scope<Queue>> m_queues;
+    Queue m_background;
+    std::vector<std::thread> m_workers;
+    std::mutex m_wake_mutex;
+    std::condition_variable m_wake;
+    std::atomic<u64> m_pending_tasks = 0;
+    bool m_stop = false;
+  };
+}
+
+#endif // GRAPENGINE_GE_THREAD_POOL_HPP
@@ -60,6 +60,7 @@ Window::~Window()
   GE_PROFILE;
   GE_INFO("Window destroy")
 
+  m_context.Shutdown();
   glfwDestroyWindow(m_window);
   glfwTerminate();
 }
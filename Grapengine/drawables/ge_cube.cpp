@@ -58,10 +58,19 @@ namespace
     // clang-format on
     return position;
   }
+
+  /**
+   * Geometry shared by every cube, so they are instances of the same mesh
+   */
+  const Drawable& GetCubeDrawable()
+  {
+    static const Drawable drawable{ GetCubeVerticesPositions(), GetIndices() };
+    return drawable;
+  }
 }
 
 //-------------------------------------------------------------------------
-Cube::Cube() : m_drawable(GetCubeVerticesPositions(), GetIndices()) {}
+Cube::Cube() : m_drawable(GetCubeDrawable()) {}
 
 const Drawable& Cube::GetDrawable() const
 {
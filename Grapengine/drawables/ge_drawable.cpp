@@ -4,8 +4,17 @@
 
 using namespace GE;
 
+namespace
+{
+  u64 NextGeometryId()
+  {
+    static std::atomic<u64> next_id = 1;
+    return next_id++;
+  }
+}
+
 Drawable::Drawable(const VerticesData& vertices, const std::vector<u32>& indices) :
-    m_vertices_data(vertices), m_indices_data(indices)
+    m_vertices_data(vertices), m_indices_data(indices), m_geometry_id(NextGeometryId())
 {
 }
 
@@ -30,3 +39,13 @@ const std::vector<u32>& Drawable::GetIndicesData() const
 {
   return m_indices_data;
 }
+
+u64 Drawable::GetGeometryId() const
+{
+  return m_geometry_id;
+}
+
+bool Drawable::operator==(const Drawable& other) const
+{
+  return m_vertices_data == other.m_vertices_data && m_indices_data == other.m_indices_data;
+}
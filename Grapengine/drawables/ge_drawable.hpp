@@ -18,11 +18,22 @@ namespace GE
     [[nodiscard]] const VerticesData& GetVerticesData() const;
     [[nodiscard]] virtual const std::vector<u32>& GetIndicesData() const;
 
-    bool operator==(const Drawable& other) const = default;
+    /**
+     * Identifier of the geometry, given to each constructed drawable and kept by its copies,
+     * since colors and texture slots are the only changes after construction. Drawables without
+     * geometry have id 0.
+     */
+    [[nodiscard]] u64 GetGeometryId() const;
+
+    /**
+     * Drawables are equal when their vertices and indices are, whatever their geometry ids
+     */
+    bool operator==(const Drawable& other) const;
 
   private:
     VerticesData m_vertices_data;
     std::vector<u32> m_indices_data;
+    u64 m_geometry_id = 0;
   };
 }
 
@@ -19,8 +19,13 @@ DrawingObject::DrawingObject()
 void DrawingObject::UpdateVerticesData(const Ptr<VerticesData>& data)
 {
   GE_PROFILE;
-  m_vao->Bind();
-  m_vbo->UpdateData(data->GetPtr(), data->GetSize());
+  UpdateVerticesData(data->GetPacked());
+}
+
+void DrawingObject::UpdateVerticesData(std::span<const PackedVertexStruct> vertices)
+{
+  GE_PROFILE;
+  m_vbo->UpdateData(vertices.data(), vertices.size_bytes());
 }
 
 void GE::DrawingObject::Bind() const
@@ -38,10 +43,14 @@ void DrawingObject::SetVerticesData(const Ptr<VerticesData>& data)
   UpdateVerticesData(data);
 }
 
+void DrawingObject::SetVerticesData(std::span<const PackedVertexStruct> vertices)
+{
+  UpdateVerticesData(vertices);
+}
+
 void DrawingObject::SetIndicesData(const std::vector<u32>& indices)
 {
   GE_PROFILE;
-  m_vao->Bind();
   m_ibo->UpdateData(indices);
   m_triangles_count = indices.size() / 3UL;
 }
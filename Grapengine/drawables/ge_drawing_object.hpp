@@ -14,9 +14,11 @@ namespace GE
     explicit DrawingObject();
 
     void SetVerticesData(const Ptr<VerticesData>& data);
+    void SetVerticesData(std::span<const PackedVertexStruct> vertices);
     void SetIndicesData(const std::vector<u32>& indices);
 
     void UpdateVerticesData(const Ptr<VerticesData>& data);
+    void UpdateVerticesData(std::span<const PackedVertexStruct> vertices);
 
     void Bind() const;
 
@@ -4,3 +4,58 @@ bool Arithmetic::IsEqual(f32 a, f32 b)
 {
   return std::fabs(a - b) < std::numeric_limits<f32>::epsilon();
 }
+
+u16 Arithmetic::ToHalfFloat(f32 value)
+{
+  const u32 bits = std::bit_cast<u32>(value);
+  const auto sign = static_cast<u16>((bits >> 16) & 0x8000);
+  const u32 abs = bits & 0x7FFFFFFF;
+
+  // Infinity and NaN, then values too large for a half
+  if (abs >= 0x7F800000)
+    return static_cast<u16>(sign | (abs > 0x7F800000 ? 0x7E00 : 0x7C00));
+  if (abs >= 0x47800000)
+    return static_cast<u16>(sign | 0x7C00);
+
+  // Values below the smallest normal half become subnormals, in units of 2^-24
+  u32 half = 0;
+  u32 remainder = 0;
+  u32 halfway = 0;
+  if (abs < 0x38800000)
+  {
+    if (abs < 0x33000000)
+      return sign;
+    const u32 shift = 126 - (abs >> 23);
+    const u32 mantissa = (abs & 0x7FFFFF) | 0x800000;
+    half = mantissa >> shift;
+    remainder = mantissa & ((1U << shift) - 1);
+    halfway = 1U << (shift - 1);
+  }
+  else
+  {
+    // Exponent rebiased from 127 to 15, keeping the 10 highest bits of the mantissa
+    half = (abs - (112U << 23)) >> 13;
+    remainder = abs & 0x1FFF;
+    halfway = 0x1000;
+  }
+
+  // A carry out of the mantissa correctly increments the exponent
+  if (remainder > halfway || (remainder == halfway && (half & 1) != 0))
+    half++;
+  return static_cast<u16>(sign | half);
+}
+
+f32 Arithmetic::FromHalfFloat(u16 bits)
+{
+  const u32 sign = u32(bits & 0x8000) << 16;
+  const u32 exponent = (bits >> 10) & 0x1F;
+  const u32 mantissa = bits & 0x3FF;
+  if (exponent == 0)
+  {
+    const f32 subnormal = std::ldexp(static_cast<f32>(mantissa), -24);
+    return sign != 0 ? -subnormal : subnormal;
+  }
+  if (exponent == 0x1F)
+    return std::bit_cast<f32>(sign | 0x7F800000 | (mantissa << 13));
+  return std::bit_cast<f32>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
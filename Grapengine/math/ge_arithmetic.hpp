@@ -1,10 +1,18 @@
 #ifndef GE_ARITHMETIC_HPP
 #define GE_ARITHMETIC_HPP
 
+#include "core/ge_type_aliases.hpp"
+
 class Arithmetic
 {
 public:
   [[nodiscard]] static bool IsEqual(f32 a, f32 b);
+
+  /**
+   * Bits of the closest IEEE 754 half-precision float, rounding ties to even
+   */
+  [[nodiscard]] static u16 ToHalfFloat(f32 value);
+  [[nodiscard]] static f32 FromHalfFloat(u16 bits);
 };
 
 #endif // GE_ARITHMETIC_HPP
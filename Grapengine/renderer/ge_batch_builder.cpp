@@ -0,0 +1,212 @@
+#include "renderer/ge_batch_builder.hpp"
+
+#include "core/ge_thread_pool.hpp"
+#include "profiling/ge_profiler.hpp"
+#include "renderer/ge_buffer_handler.hpp"
+#include "renderer/ge_frame_uniforms.hpp"
+
+using namespace GE;
+
+namespace
+{
+  constexpr u64 DEPTH_BITS = 24;
+  constexpr u64 ARRAY_BITS = std::bit_width(MAX_TEXTURE_ARRAYS - 1);
+  constexpr u64 MATERIAL_BITS = 8;
+  constexpr u64 TEXTURE_BITS = 16;
+  constexpr u64 TRANSLUCENT_BIT = 63;
+  static_assert(DEPTH_BITS + ARRAY_BITS + MATERIAL_BITS + TEXTURE_BITS <= TRANSLUCENT_BIT,
+                "Draw key fields overlap the translucent bit");
+
+  // Fields of the draw keys, from the highest bits below the translucent one
+  constexpr u64 OPAQUE_ARRAY_SHIFT = TRANSLUCENT_BIT - ARRAY_BITS;
+  constexpr u64 OPAQUE_MATERIAL_SHIFT = OPAQUE_ARRAY_SHIFT - MATERIAL_BITS;
+  constexpr u64 OPAQUE_TEXTURE_SHIFT = OPAQUE_MATERIAL_SHIFT - TEXTURE_BITS;
+  constexpr u64 OPAQUE_DEPTH_SHIFT = OPAQUE_TEXTURE_SHIFT - DEPTH_BITS;
+  constexpr u64 TRANSLUCENT_DEPTH_SHIFT = TRANSLUCENT_BIT - DEPTH_BITS;
+  constexpr u64 TRANSLUCENT_ARRAY_SHIFT = TRANSLUCENT_DEPTH_SHIFT - ARRAY_BITS;
+  constexpr u64 TRANSLUCENT_MATERIAL_SHIFT = TRANSLUCENT_ARRAY_SHIFT - MATERIAL_BITS;
+  constexpr u64 TRANSLUCENT_TEXTURE_SHIFT = TRANSLUCENT_MATERIAL_SHIFT - TEXTURE_BITS;
+
+  /**
+   * Maximum number of objects handled by each task of the thread pool
+   */
+  constexpr u64 DRAWS_GRAIN = 256;
+
+  /**
+   * Number of vertices transformed at a time by each task
+   */
+  constexpr u64 TRANSFORM_BLOCK = 128;
+
+  /**
+   * Bits of a non-negative float keep its order, so the highest ones are a depth bucket
+   */
+  u64 DepthBucket(f32 depth)
+  {
+    const u32 bits = std::bit_cast<u32>(std::max(depth, 0.0F));
+    return bits >> (32 - DEPTH_BITS);
+  }
+
+  /**
+   * Opaque objects are grouped by texture array, material and texture and drawn front to back.
+   * Translucent objects come after them, drawn back to front, and only then grouped by texture
+   * array, material and texture
+   * [63] translucent | array | material | texture | depth
+   * [63] translucent | inverted depth | array | material | texture
+   */
+  u64 MakeDrawKey(bool translucent, f32 depth, u64 array, u64 material, u64 texture)
+  {
+    const u64 depth_bucket = DepthBucket(depth);
+    array &= (1ULL << ARRAY_BITS) - 1;
+    material &= (1ULL << MATERIAL_BITS) - 1;
+    texture &= (1ULL << TEXTURE_BITS) - 1;
+    if (!translucent)
+    {
+      return (array << OPAQUE_ARRAY_SHIFT) | (material << OPAQUE_MATERIAL_SHIFT) |
+             (texture << OPAQUE_TEXTURE_SHIFT) | (depth_bucket << OPAQUE_DEPTH_SHIFT);
+    }
+
+    const u64 inverted_depth = ~depth_bucket & ((1ULL << DEPTH_BITS) - 1);
+    return (1ULL << TRANSLUCENT_BIT) | (inverted_depth << TRANSLUCENT_DEPTH_SHIFT) |
+           (array << TRANSLUCENT_ARRAY_SHIFT) | (material << TRANSLUCENT_MATERIAL_SHIFT) |
+           (texture << TRANSLUCENT_TEXTURE_SHIFT);
+  }
+
+  /**
+   * Stable LSD radix sort of the records by key, one byte for each pass. Passes where every
+   * key has the same byte are skipped.
+   */
+  template <typename Record>
+  void RadixSort(std::vector<Record>& records, std::vector<Record>& scratch)
+  {
+    GE_PROFILE;
+    scratch.resize(records.size());
+    for (u64 shift = 0; shift < 64; shift += 8)
+    {
+      std::array<u64, 256> offsets{};
+      for (const Record& rec : records)
+        offsets[(rec.key >> shift) & 0xFF]++;
+
+      if (std::ranges::find(offsets, records.size()) != offsets.end())
+        continue;
+
+      std::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), 0ULL);
+      for (const Record& rec : records)
+        scratch[offsets[(rec.key >> shift) & 0xFF]++] = rec;
+      records.swap(scratch);
+    }
+  }
+}
+
+BatchBuilder::BatchBuilder() = default;
+
+void BatchBuilder::Begin(const Vec3& viewPosition, std::span<const i32> textureLayers)
+{
+  m_view_position = viewPosition;
+  m_texture_layers.assign(textureLayers.begin(), textureLayers.end());
+  m_draws.clear();
+}
+
+void BatchBuilder::Push(const BatchDraw& draw)
+{
+  // Empty objects have nothing to draw, nor a texture slot to be keyed by
+  if (!draw.vertices.empty() && !draw.indices.empty())
+    m_draws.push_back(draw);
+}
+
+void BatchBuilder::Push(std::span<const BatchDraw> draws)
+{
+  GE_PROFILE;
+  m_draws.reserve(m_draws.size() + draws.size());
+  for (const BatchDraw& draw : draws)
+    Push(draw);
+}
+
+BatchBuilder::BatchSize BatchBuilder::Layout()
+{
+  GE_PROFILE;
+  m_records.resize(m_draws.size());
+  ThreadPool::Get().ParallelFor(m_draws.size(),
+                                DRAWS_GRAIN,
+                                [&](u64 begin, u64 end)
+                                {
+                                  for (u64 i = begin; i < end; i++)
+                                    m_records[i] = { MakeKey(m_draws[i]), i };
+                                });
+
+  RadixSort(m_records, m_sorted_records);
+
+  // Each object is written after the ones sorted before it, so the offsets are a prefix sum
+  BatchSlice next{ 0, 0 };
+  m_slices.resize(m_records.size());
+  m_ranges.clear();
+  for (u64 i = 0; i < m_records.size(); i++)
+  {
+    const BatchDraw& draw = m_draws[m_records[i].draw];
+    const u32 texture_array = GetTextureArray(draw);
+    if (m_ranges.empty() || m_ranges.back().texture_array != texture_array)
+      m_ranges.push_back({ texture_array, next.first_index, 0 });
+    m_ranges.back().indices_count += draw.indices.size();
+
+    m_slices[i] = next;
+    next.first_vertex += draw.vertices.size();
+    next.first_index += draw.indices.size();
+  }
+  return { next.first_vertex, next.first_index };
+}
+
+void BatchBuilder::Write(std::span<PackedVertexStruct> vertices, std::span<u32> indices) const
+{
+  GE_PROFILE;
+  ThreadPool::Get().ParallelFor(
+    m_records.size(),
+    DRAWS_GRAIN,
+    [&](u64 begin, u64 end)
+    {
+      // Objects are transformed in full precision, a block at a time, before being packed into
+      // their slice, so the tasks do not allocate
+      std::array<VertexStruct, TRANSFORM_BLOCK> transformed{};
+      for (u64 i = begin; i < end; i++)
+      {
+        const BatchDraw& draw = m_draws[m_records[i].draw];
+        const BatchSlice& slice = m_slices[i];
+
+        for (u64 first = 0; first < draw.vertices.size(); first += TRANSFORM_BLOCK)
+        {
+          const std::span<const VertexStruct> source = draw.vertices.subspan(first).first(
+            std::min<u64>(TRANSFORM_BLOCK, draw.vertices.size() - first));
+          const std::span<VertexStruct> block{ transformed.data(), source.size() };
+          std::ranges::copy(source, block.begin());
+          BufferHandler::TransformVertices(block, draw.model_mat);
+          VerticesData::Pack(block, vertices.subspan(slice.first_vertex + first, block.size()));
+        }
+
+        const auto base_vertex = static_cast<u32>(slice.first_vertex);
+        std::ranges::transform(draw.indices,
+                               indices.subspan(slice.first_index).begin(),
+                               [&](u32 idx) { return idx + base_vertex; });
+      }
+    });
+}
+
+u64 BatchBuilder::MakeKey(const BatchDraw& draw) const
+{
+  // The depth of the object is the one of its origin, so keying does not read its vertices
+  const Vec3 origin = draw.model_mat * Vec3{};
+
+  // Every batched object is drawn by the material shader
+  constexpr u64 material = 0;
+  const f32 depth = origin.Distance(m_view_position);
+  return MakeDrawKey(
+    draw.translucent, depth, GetTextureArray(draw), material, draw.vertices.front().texture_slot);
+}
+
+u32 BatchBuilder::GetTextureArray(const BatchDraw& draw) const
+{
+  // The texture slots of an object are expected to share their texture array
+  return TextureArrayOf(m_texture_layers, draw.vertices.front().texture_slot);
+}
+
+const std::vector<BatchBuilder::BatchRange>& BatchBuilder::GetRanges() const
+{
+  return m_ranges;
+}
@@ -0,0 +1,108 @@
+#ifndef GRAPENGINE_GE_BATCH_BUILDER_HPP
+#define GRAPENGINE_GE_BATCH_BUILDER_HPP
+
+#include "math/ge_vector.hpp"
+#include "renderer/ge_vertices_data.hpp"
+
+namespace GE
+{
+  /**
+   * Object of a draw list. Its geometry is read in place, so it must live until the batch is
+   * built. Whether it is translucent is told by the caller, and its depth is the one of the
+   * translation of its model matrix, so the vertices are not read to sort it.
+   */
+  struct BatchDraw
+  {
+    std::span<const VertexStruct> vertices;
+    std::span<const u32> indices;
+    Mat4 model_mat;
+    bool translucent = false;
+  };
+
+  /**
+   * CPU side of the batch renderer, that assembles the vertices and indices of many objects in
+   * a single pair of buffers.
+   * Each pushed object becomes a draw record with a 64-bit sort key (opaque or translucent,
+   * depth, texture array, material and texture). Building the batch sorts the records, not the
+   * vertices, and appends each object in key order with its indices offset by the running count
+   * of batched vertices, so the whole build is linear in the batch size.
+   * Consecutive objects in the same texture array form a range of the batch, drawn on its own.
+   * A prefix sum over the sorted counts gives each object its own slice of the batch buffers,
+   * so the objects are transformed and packed on the thread pool without locks.
+   */
+  class BatchBuilder
+  {
+  public:
+    BatchBuilder();
+
+    /**
+     * Start a new batch
+     * @param viewPosition position the depth of the objects is measured from
+     * @param textureLayers texture array and layer of each texture slot, as in FrameUniforms
+     */
+    void Begin(const Vec3& viewPosition, std::span<const i32> textureLayers = {});
+
+    void Push(const BatchDraw& draw);
+    void Push(std::span<const BatchDraw> draws);
+
+    struct BatchSize
+    {
+      u64 vertices;
+      u64 indices;
+    };
+
+    /**
+     * Indices of the batch whose objects sample the same texture array
+     */
+    struct BatchRange
+    {
+      u32 texture_array;
+      u64 first_index;
+      u64 indices_count;
+    };
+
+    /**
+     * Sort the pushed objects by their keys, opaque objects front to back and then translucent
+     * ones back to front, and give each one its slice of the batch
+     * @return size of the whole batch
+     */
+    BatchSize Layout();
+
+    /**
+     * Ranges of the laid out batch, in draw order
+     */
+    [[nodiscard]] const std::vector<BatchRange>& GetRanges() const;
+
+    /**
+     * Transform and pack the laid out objects into their slices of the buffers, which may be
+     * mapped GPU memory. Indices are relative to the first vertex of the batch.
+     */
+    void Write(std::span<PackedVertexStruct> vertices, std::span<u32> indices) const;
+
+  private:
+    [[nodiscard]] u64 MakeKey(const BatchDraw& draw) const;
+    [[nodiscard]] u32 GetTextureArray(const BatchDraw& draw) const;
+
+    struct DrawRecord
+    {
+      u64 key;
+      u64 draw;
+    };
+
+    struct BatchSlice
+    {
+      u64 first_vertex;
+      u64 first_index;
+    };
+
+    Vec3 m_view_position;
+    std::vector<i32> m_texture_layers;
+    std::vector<BatchDraw> m_draws;
+    std::vector<DrawRecord> m_records;
+    std::vector<DrawRecord> m_sorted_records;
+    std::vector<BatchSlice> m_slices;
+    std::vector<BatchRange> m_ranges;
+  };
+} // GE
+
+#endif // GRAPENGINE_GE_BATCH_BUILDER_HPP
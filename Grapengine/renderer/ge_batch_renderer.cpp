@@ -1,53 +1,78 @@
 #include "ge_batch_renderer.hpp"
 
-#include "ge_buffer_handler.hpp"
+#include "profiling/ge_profiler.hpp"
 #include "renderer/shader_programs/ge_material_shader.hpp"
 
 #include <glad/glad.h>
 
 using namespace GE;
 
-BatchRenderer::BatchRenderer() :
-    m_vertices_data(std::make_pair(VerticesData::Make(), std::vector<u32>{}))
+namespace
 {
+  /**
+   * Initial capacity of each region of the streaming buffers, which grow with the batches
+   */
+  constexpr u64 REGION_VERTICES = 1ULL << 16;
+  constexpr u64 REGION_INDICES = 1ULL << 17;
 }
 
-void BatchRenderer::PushObject(VerticesData&& vd,
-                               const std::vector<u32>& indices,
-                               const Mat4& modelMat)
+BatchRenderer::BatchRenderer() :
+    m_vertex_stream(StreamBuffer::Make(sizeof(PackedVertexStruct), REGION_VERTICES)),
+    m_index_stream(StreamBuffer::Make(sizeof(u32), REGION_INDICES))
 {
-  const Ptr<VerticesData> shader_vertices_data = m_vertices_data.first;
-  BufferHandler::UpdatePosition(vd, modelMat);
-  shader_vertices_data->RawPushData(std::move(vd));
+}
 
-  std::vector<u32>& indices_data = m_vertices_data.second;
-  if (indices_data.empty())
-  {
-    indices_data.insert(indices_data.end(), indices.begin(), indices.end());
-    return;
-  }
-  const u32 current_max_id = indices_data.empty() ? 0 : std::ranges::max(indices_data);
-  indices_data.reserve(indices_data.size() + indices.size());
-  std::ranges::for_each(indices, [&](u32 i) { indices_data.push_back(i + current_max_id + 1); });
+void BatchRenderer::PushObjects(std::span<const BatchDraw> draws)
+{
+  m_builder.Push(draws);
 }
 
-void BatchRenderer::Begin()
+void BatchRenderer::Begin(const Vec3& viewPosition, std::span<const i32> textureLayers)
 {
-  m_vertices_data.first->Clear();
-  m_vertices_data.second.clear();
+  m_builder.Begin(viewPosition, textureLayers);
 }
 
-void BatchRenderer::End()
+void BatchRenderer::End(IShaderProgram& shader)
 {
-  m_vertices_data.first->SortVertices();
-  m_drawing_object.SetVerticesData(m_vertices_data.first);
-  m_drawing_object.SetIndicesData(m_vertices_data.second);
+  GE_PROFILE;
+  const auto [vertices_count, indices_count] = m_builder.Layout();
+  if (indices_count == 0)
+    return;
 
-  Draw();
+  auto* vertices = static_cast<PackedVertexStruct*>(m_vertex_stream->Append(vertices_count));
+  auto* indices = static_cast<u32*>(m_index_stream->Append(indices_count));
+  m_builder.Write({ vertices, vertices_count }, { indices, indices_count });
+
+  UpdateVertexArray();
+  m_vao->Bind();
+  for (const auto& [texture_array, first_index, count] : m_builder.GetRanges())
+  {
+    shader.UpdateTexture(static_cast<i32>(texture_array));
+    const u64 indices_offset = (m_index_stream->GetFirstElement() + first_index) * sizeof(u32);
+    glDrawElementsBaseVertex(GL_TRIANGLES,
+                             static_cast<i32>(count),
+                             GL_UNSIGNED_INT,
+                             reinterpret_cast<void*>(indices_offset), // NOLINT(*-no-int-to-ptr)
+                             static_cast<i32>(m_vertex_stream->GetFirstElement()));
+  }
+}
+
+void BatchRenderer::EndFrame()
+{
+  m_vertex_stream->EndFrame();
+  m_index_stream->EndFrame();
 }
 
-void BatchRenderer::Draw() const
+void BatchRenderer::UpdateVertexArray()
 {
-  m_drawing_object.Bind();
-  glDrawElements(GL_TRIANGLES, m_drawing_object.IndicesCount(), GL_UNSIGNED_INT, nullptr);
+  // A reallocated buffer may reuse the id of the deleted one, so allocations are compared
+  if (m_vao != nullptr && m_vao_vertex_allocation == m_vertex_stream->GetAllocationsCount() &&
+      m_vao_index_allocation == m_index_stream->GetAllocationsCount())
+    return;
+
+  m_vao = VertexArray::Make();
+  m_vao->Bind();
+  m_vao->SetStreamBuffers(m_vertex_stream, m_index_stream, VerticesData::GetLayout());
+  m_vao_vertex_allocation = m_vertex_stream->GetAllocationsCount();
+  m_vao_index_allocation = m_index_stream->GetAllocationsCount();
 }
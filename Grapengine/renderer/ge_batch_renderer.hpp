@@ -1,28 +1,51 @@
 #ifndef GRAPENGINE_GE_BATCH_RENDERER_HPP
 #define GRAPENGINE_GE_BATCH_RENDERER_HPP
 
-#include "drawables/ge_drawing_object.hpp"
+#include "renderer/ge_batch_builder.hpp"
+#include "renderer/ge_stream_buffer.hpp"
+#include "renderer/ge_vertex_array.hpp"
 #include "renderer/ge_vertices_data.hpp"
 #include "renderer/shader_programs/ge_material_shader.hpp"
 
 namespace GE
 {
+  /**
+   * Draws the batch from streaming buffers: the builder writes the vertices and indices straight
+   * into the mapped region of the frame, after the batches of the previous passes, and they are
+   * drawn with their base vertex and offset, a draw for each range of objects in the same
+   * texture array
+   */
   class BatchRenderer
   {
   public:
     explicit BatchRenderer();
 
-    void Begin();
+    void Begin(const Vec3& viewPosition, std::span<const i32> textureLayers);
 
-    void End();
+    /**
+     * Draw the batch with the active shader, which is told the texture array of each draw
+     */
+    void End(IShaderProgram& shader);
 
-    void PushObject(VerticesData&& vd, const std::vector<u32>& indices, const Mat4& modelMat);
+    void PushObjects(std::span<const BatchDraw> draws);
 
-  private:
-    void Draw() const;
+    /**
+     * Fence the streamed batches of every pass of the frame
+     */
+    void EndFrame();
 
-    DrawingObject m_drawing_object;
-    std::pair<Ptr<VerticesData>, std::vector<u32>> m_vertices_data;
+  private:
+    /**
+     * Point a vertex array at the streaming buffers, again after they are reallocated
+     */
+    void UpdateVertexArray();
+
+    BatchBuilder m_builder;
+    Ptr<StreamBuffer> m_vertex_stream;
+    Ptr<StreamBuffer> m_index_stream;
+    Ptr<VertexArray> m_vao;
+    u64 m_vao_vertex_allocation = 0;
+    u64 m_vao_index_allocation = 0;
   };
 } // GE
 
@@ -1,19 +1,228 @@
 #include "ge_buffer_handler.hpp"
 
+#include "math/ge_arithmetic.hpp"
 #include "profiling/ge_profiler.hpp"
 
+#if defined(__AVX2__)
+  #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #include <emmintrin.h>
+  #define GE_TRANSFORM_SSE
+#endif
+
 using namespace GE;
 
+namespace
+{
+  /**
+   * Coefficients of the transform of one object: the upper 3x4 part of the model matrix and the
+   * normal matrix, both by rows
+   */
+  struct TransformCoefficients
+  {
+    std::array<f32, 12> model;
+    std::array<f32, 9> normal;
+  };
+
+  TransformCoefficients MakeCoefficients(const Mat4& modelMatrix, const Mat3& normalMatrix)
+  {
+    TransformCoefficients coef{};
+    for (u32 row = 0; row < 3; row++)
+    {
+      for (u32 col = 0; col < 4; col++)
+        coef.model.at(row * 4 + col) = modelMatrix(row, col);
+      for (u32 col = 0; col < 3; col++)
+        coef.normal.at(row * 3 + col) = normalMatrix(row, col);
+    }
+    return coef;
+  }
+
+  void TransformScalar(std::span<VertexStruct> vertices, const TransformCoefficients& coef)
+  {
+    const auto& m = coef.model;
+    const auto& n = coef.normal;
+    for (VertexStruct& vs : vertices)
+    {
+      const auto [px, py, pz] = vs.position;
+      vs.position = { m[0] * px + m[1] * py + m[2] * pz + m[3],
+                      m[4] * px + m[5] * py + m[6] * pz + m[7],
+                      m[8] * px + m[9] * py + m[10] * pz + m[11] };
+
+      const auto [nx, ny, nz] = vs.normal;
+      vs.normal = Vec3{ n[0] * nx + n[1] * ny + n[2] * nz,
+                        n[3] * nx + n[4] * ny + n[5] * nz,
+                        n[6] * nx + n[7] * ny + n[8] * nz }
+                    .Normalize();
+    }
+  }
+
+#if defined(__AVX2__) || defined(GE_TRANSFORM_SSE)
+  #if defined(__AVX2__)
+  struct Lanes
+  {
+    using Reg = __m256;
+    static constexpr u64 WIDTH = 8;
+    static Reg Load(const f32* p) { return _mm256_load_ps(p); }
+    static void Store(f32* p, Reg r) { _mm256_store_ps(p, r); }
+    static Reg Set(f32 v) { return _mm256_set1_ps(v); }
+    static Reg Add(Reg a, Reg b) { return _mm256_add_ps(a, b); }
+    static Reg Mul(Reg a, Reg b) { return _mm256_mul_ps(a, b); }
+    static Reg Div(Reg a, Reg b) { return _mm256_div_ps(a, b); }
+    static Reg Sqrt(Reg a) { return _mm256_sqrt_ps(a); }
+  };
+  #else
+  struct Lanes
+  {
+    using Reg = __m128;
+    static constexpr u64 WIDTH = 4;
+    static Reg Load(const f32* p) { return _mm_load_ps(p); }
+    static void Store(f32* p, Reg r) { _mm_store_ps(p, r); }
+    static Reg Set(f32 v) { return _mm_set1_ps(v); }
+    static Reg Add(Reg a, Reg b) { return _mm_add_ps(a, b); }
+    static Reg Mul(Reg a, Reg b) { return _mm_mul_ps(a, b); }
+    static Reg Div(Reg a, Reg b) { return _mm_div_ps(a, b); }
+    static Reg Sqrt(Reg a) { return _mm_sqrt_ps(a); }
+  };
+  #endif
+
+  /**
+   * Positions and normals of a block of vertices in SoA layout
+   */
+  struct alignas(32) VertexBlock
+  {
+    std::array<f32, Lanes::WIDTH> px;
+    std::array<f32, Lanes::WIDTH> py;
+    std::array<f32, Lanes::WIDTH> pz;
+    std::array<f32, Lanes::WIDTH> nx;
+    std::array<f32, Lanes::WIDTH> ny;
+    std::array<f32, Lanes::WIDTH> nz;
+  };
+
+  /**
+   * Row of the transform broadcast to every lane, with a zero translation for the normals
+   */
+  struct RowLanes
+  {
+    Lanes::Reg c0;
+    Lanes::Reg c1;
+    Lanes::Reg c2;
+    Lanes::Reg c3;
+  };
+
+  RowLanes BroadcastRow(std::span<const f32> row)
+  {
+    const f32 translation = row.size() > 3 ? row[3] : 0.0F;
+    return { Lanes::Set(row[0]), Lanes::Set(row[1]), Lanes::Set(row[2]), Lanes::Set(translation) };
+  }
+
+  Lanes::Reg Apply(const RowLanes& row, Lanes::Reg x, Lanes::Reg y, Lanes::Reg z)
+  {
+    const Lanes::Reg xy = Lanes::Add(Lanes::Mul(row.c0, x), Lanes::Mul(row.c1, y));
+    return Lanes::Add(Lanes::Add(xy, Lanes::Mul(row.c2, z)), row.c3);
+  }
+
+  /**
+   * Transform the vertices a block at a time and return how many were transformed, leaving the
+   * remainder to the scalar code
+   */
+  u64 TransformBlocks(std::span<VertexStruct> vertices, const TransformCoefficients& coef)
+  {
+    // Coefficients are broadcast once for the whole object
+    const std::span<const f32> model = coef.model;
+    const std::span<const f32> normal = coef.normal;
+    const std::array<RowLanes, 3> m{ BroadcastRow(model.subspan(0, 4)),
+                                     BroadcastRow(model.subspan(4, 4)),
+                                     BroadcastRow(model.subspan(8, 4)) };
+    const std::array<RowLanes, 3> n{ BroadcastRow(normal.subspan(0, 3)),
+                                     BroadcastRow(normal.subspan(3, 3)),
+                                     BroadcastRow(normal.subspan(6, 3)) };
+
+    VertexBlock block{};
+    const u64 blocks_end = vertices.size() - vertices.size() % Lanes::WIDTH;
+    for (u64 first = 0; first < blocks_end; first += Lanes::WIDTH)
+    {
+      const auto block_vertices = vertices.subspan(first, Lanes::WIDTH);
+      for (u64 i = 0; i < Lanes::WIDTH; i++)
+      {
+        const VertexStruct& vs = block_vertices[i];
+        block.px[i] = vs.position.x;
+        block.py[i] = vs.position.y;
+        block.pz[i] = vs.position.z;
+        block.nx[i] = vs.normal.x;
+        block.ny[i] = vs.normal.y;
+        block.nz[i] = vs.normal.z;
+      }
+
+      const Lanes::Reg px = Lanes::Load(block.px.data());
+      const Lanes::Reg py = Lanes::Load(block.py.data());
+      const Lanes::Reg pz = Lanes::Load(block.pz.data());
+      Lanes::Store(block.px.data(), Apply(m[0], px, py, pz));
+      Lanes::Store(block.py.data(), Apply(m[1], px, py, pz));
+      Lanes::Store(block.pz.data(), Apply(m[2], px, py, pz));
+
+      const Lanes::Reg nx = Lanes::Load(block.nx.data());
+      const Lanes::Reg ny = Lanes::Load(block.ny.data());
+      const Lanes::Reg nz = Lanes::Load(block.nz.data());
+      const Lanes::Reg tx = Apply(n[0], nx, ny, nz);
+      const Lanes::Reg ty = Apply(n[1], nx, ny, nz);
+      const Lanes::Reg tz = Apply(n[2], nx, ny, nz);
+      const Lanes::Reg norm = Lanes::Sqrt(
+        Lanes::Add(Lanes::Add(Lanes::Mul(tx, tx), Lanes::Mul(ty, ty)), Lanes::Mul(tz, tz)));
+      Lanes::Store(block.nx.data(), Lanes::Div(tx, norm));
+      Lanes::Store(block.ny.data(), Lanes::Div(ty, norm));
+      Lanes::Store(block.nz.data(), Lanes::Div(tz, norm));
+
+      for (u64 i = 0; i < Lanes::WIDTH; i++)
+      {
+        VertexStruct& vs = block_vertices[i];
+        vs.position = { block.px[i], block.py[i], block.pz[i] };
+        vs.normal = { block.nx[i], block.ny[i], block.nz[i] };
+      }
+    }
+    return blocks_end;
+  }
+#else
+  u64 TransformBlocks(std::span<VertexStruct>, const TransformCoefficients&)
+  {
+    return 0;
+  }
+#endif
+}
+
 void BufferHandler::UpdatePosition(VerticesData& vd, const Mat4& modelMatrix)
 {
   GE_PROFILE;
-  auto& vertices = vd.GetData();
-  std::ranges::for_each(vertices,
-                        [&](VertexStruct& vs) { vs.position = modelMatrix * vs.position; });
-
-  std::ranges::for_each(vertices,
-                        [&](VertexStruct& vs) {
-                          vs.normal =
-                            (modelMatrix.Inverse().Transpose().ToMat3() * vs.normal).Normalize();
-                        });
+  TransformVertices(vd.GetData(), modelMatrix);
+}
+
+void BufferHandler::TransformVertices(std::span<VertexStruct> vertices, const Mat4& modelMatrix)
+{
+  const TransformCoefficients coef = MakeCoefficients(modelMatrix, NormalMatrix(modelMatrix));
+  const u64 transformed = TransformBlocks(vertices, coef);
+  TransformScalar(vertices.subspan(transformed), coef);
+}
+
+Mat3 BufferHandler::NormalMatrix(const Mat4& modelMatrix)
+{
+  // Columns of the inverse transpose are the cross products of the columns of the matrix,
+  // divided by its determinant
+  const auto column = [&](u32 col)
+  { return Vec3{ modelMatrix(0, col), modelMatrix(1, col), modelMatrix(2, col) }; };
+  const Vec3 c0 = column(0);
+  const Vec3 c1 = column(1);
+  const Vec3 c2 = column(2);
+  const std::array<Vec3, 3> cofactors{ c1.Cross(c2), c2.Cross(c0), c0.Cross(c1) };
+
+  // A singular matrix keeps its cofactors, since the normals are normalized after
+  const f32 det = c0.Dot(cofactors[0]);
+  const f32 inv_det = Arithmetic::IsEqual(det, 0.0F) ? 1.0F : 1.0F / det;
+
+  Mat3 res;
+  for (u32 col = 0; col < 3; col++)
+  {
+    res(0, col) = cofactors.at(col).x * inv_det;
+    res(1, col) = cofactors.at(col).y * inv_det;
+    res(2, col) = cofactors.at(col).z * inv_det;
+  }
+  return res;
 }
@@ -9,7 +9,18 @@ namespace GE
   class BufferHandler
   {
   public:
+    /**
+     * Transform the positions by the model matrix and the normals by its normal matrix, which is
+     * computed once for the whole object. Vertices are transformed in blocks, with SSE or AVX2
+     * when the build targets them, and the remainder with scalar code.
+     */
     static void UpdatePosition(VerticesData& vd, const Mat4& modelMatrix);
+    static void TransformVertices(std::span<VertexStruct> vertices, const Mat4& modelMatrix);
+
+    /**
+     * Inverse transpose of the upper 3x3 part of an affine model matrix
+     */
+    static Mat3 NormalMatrix(const Mat4& modelMatrix);
   };
 
 } // GE
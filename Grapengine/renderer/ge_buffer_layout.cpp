@@ -19,6 +19,18 @@ namespace
       return sizeof(f32) * 2;
     case DataPurpose::TEX_ID_INT:
       return sizeof(i32);
+    case DataPurpose::MODEL_MATRIX_F16:
+      return sizeof(f32) * 16;
+    case DataPurpose::NORMAL_MATRIX_F9:
+      return sizeof(f32) * 9;
+    case DataPurpose::COLOR_RGBA8:
+      return sizeof(u8) * 4;
+    case DataPurpose::TEXTURE_COORDINATE_H2:
+      return sizeof(u16) * 2;
+    case DataPurpose::NORMAL_SNORM_1010102:
+      return sizeof(u32);
+    case DataPurpose::TEX_ID_U16:
+      return sizeof(u16);
     }
     Platform::Unreachable();
   }
@@ -35,6 +47,10 @@ BufferLayout::BufferLayout(std::list<BufferElem> list) : m_stride(0)
     offset += elem.size;
     m_stride += elem.size;
   }
+
+  // Vertex attributes must be aligned to 4 bytes, which packed formats may break
+  constexpr u64 alignment = 4;
+  m_stride = (m_stride + alignment - 1) / alignment * alignment;
 }
 
 void BufferLayout::ForEachElement(const std::function<void(BufferElem)>& action) const
@@ -54,7 +70,9 @@ std::list<BufferElem> GE::BufferLayout::BuildElementsList(std::initializer_list<
   for (const auto& purpose : types)
   {
     auto size = GetShaderDataTypeSize(purpose);
-    elems.emplace_back(purpose, size, offset, false);
+    const bool normalized =
+      purpose == DataPurpose::COLOR_RGBA8 || purpose == DataPurpose::NORMAL_SNORM_1010102;
+    elems.emplace_back(purpose, size, offset, normalized);
     offset += size;
   }
   return elems;
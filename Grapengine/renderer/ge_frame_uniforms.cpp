@@ -0,0 +1,109 @@
+#include "renderer/ge_frame_uniforms.hpp"
+
+#include "profiling/ge_profiler.hpp"
+
+#include <cstring>
+
+using namespace GE;
+
+namespace
+{
+  /**
+   * Replace the block and tell whether it has changed, so unchanged blocks are not uploaded
+   */
+  template <typename Block>
+  bool Assign(Block& current, const Block& block)
+  {
+    if (std::memcmp(&current, &block, sizeof(Block)) == 0)
+      return false;
+    current = block;
+    return true;
+  }
+}
+
+FrameUniforms& FrameUniforms::Get()
+{
+  static FrameUniforms uniforms;
+  return uniforms;
+}
+
+FrameUniforms::FrameUniforms() :
+    m_camera_buffer(UniformBuffer::Make(sizeof(CameraBlock), CAMERA_BINDING)),
+    m_lights_buffer(UniformBuffer::Make(sizeof(LightsBlock), LIGHTS_BINDING)),
+    m_textures_buffer(UniformBuffer::Make(sizeof(TexturesBlock), TEXTURES_BINDING))
+{
+  // Offsets of the std140 layout of the blocks in the material shaders
+  static_assert(sizeof(CameraBlock) == 80);
+  static_assert(offsetof(CameraBlock, view_position) == 64);
+  static_assert(sizeof(LightBlock) == 48);
+  static_assert(offsetof(LightBlock, color) == 16);
+  static_assert(offsetof(LightBlock, specular_shininess) == 32);
+  static_assert(offsetof(LightsBlock, ambient_color) == 48 * MAX_LIGHTS);
+  static_assert(offsetof(LightsBlock, lights_count) == 48 * MAX_LIGHTS + 16);
+  static_assert(sizeof(TexturesBlock) == 4 * MAX_TEXTURE_SLOTS);
+}
+
+void FrameUniforms::SetCamera(const Mat4& viewProj, const Vec3& viewPosition)
+{
+  CameraBlock camera{};
+  std::copy_n(viewProj.ValuePtr(), camera.view_projection.size(), camera.view_projection.begin());
+  camera.view_position = viewPosition;
+  m_camera_changed = Assign(m_camera, camera) || m_camera_changed;
+}
+
+void FrameUniforms::SetAmbientLight(Color color, f32 strength)
+{
+  LightsBlock lights = m_lights;
+  lights.ambient_color = color.ToVec3();
+  lights.ambient_strength = strength;
+  m_lights_changed = Assign(m_lights, lights) || m_lights_changed;
+}
+
+void FrameUniforms::SetLightSources(std::span<const LightSource> lightSources)
+{
+  if (lightSources.size() > MAX_LIGHTS)
+    GE_WARN("Only the first {} of {} light sources are used", MAX_LIGHTS, lightSources.size())
+
+  LightsBlock lights = m_lights;
+  lights.lights = {};
+  const auto count = std::min<u64>(lightSources.size(), MAX_LIGHTS);
+  for (u64 i = 0; i < count; i++)
+  {
+    const auto& [pos, color, str, spec, shine] = lightSources[i];
+    lights.lights.at(i) = { pos, str, color.ToVec3(), spec, f32(shine), {} };
+  }
+  lights.lights_count = static_cast<i32>(count);
+  m_lights_changed = Assign(m_lights, lights) || m_lights_changed;
+}
+
+void FrameUniforms::SetTextureLayers(std::span<const i32> layers)
+{
+  GE_ASSERT(layers.size() <= MAX_TEXTURE_SLOTS,
+            "Only the first {} of {} texture slots are used",
+            MAX_TEXTURE_SLOTS,
+            layers.size());
+
+  TexturesBlock textures{};
+  const auto count = std::min<u64>(layers.size(), MAX_TEXTURE_SLOTS);
+  std::copy_n(layers.begin(), count, textures.layers.begin());
+  m_textures_changed = Assign(m_textures, textures) || m_textures_changed;
+}
+
+std::span<const i32> FrameUniforms::GetTextureLayers() const
+{
+  return m_textures.layers;
+}
+
+void FrameUniforms::Upload()
+{
+  GE_PROFILE;
+  if (m_camera_changed)
+    m_camera_buffer->SetData(&m_camera, sizeof(CameraBlock));
+  if (m_lights_changed)
+    m_lights_buffer->SetData(&m_lights, sizeof(LightsBlock));
+  if (m_textures_changed)
+    m_textures_buffer->SetData(&m_textures, sizeof(TexturesBlock));
+  m_camera_changed = false;
+  m_lights_changed = false;
+  m_textures_changed = false;
+}
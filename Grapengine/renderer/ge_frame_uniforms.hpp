@@ -0,0 +1,116 @@
+#ifndef GRAPENGINE_GE_FRAME_UNIFORMS_HPP
+#define GRAPENGINE_GE_FRAME_UNIFORMS_HPP
+
+#include "drawables/ge_color.hpp"
+#include "math/ge_vector.hpp"
+#include "renderer/ge_light_source.hpp"
+#include "renderer/ge_uniform_buffer.hpp"
+
+namespace GE
+{
+  /**
+   * Maximum number of light sources, which must match MAX_LIGHTS of the material shader
+   */
+  constexpr u32 MAX_LIGHTS = 10;
+
+  /**
+   * Maximum number of texture arrays and texture slots, which must match MAX_TEXTURE_ARRAYS and
+   * MAX_TEXTURE_SLOTS of the material shader
+   */
+  constexpr u32 MAX_TEXTURE_ARRAYS = 16;
+  constexpr u32 MAX_TEXTURE_SLOTS = 1024;
+
+  /**
+   * Texture layers are packed as (array << TEXTURE_LAYER_BITS | layer)
+   */
+  constexpr u32 TEXTURE_LAYER_BITS = 16;
+
+  /**
+   * Texture array of a slot in a table of texture layers. Slots out of the table are white, in
+   * the first array.
+   */
+  constexpr u32 TextureArrayOf(std::span<const i32> layers, u32 slot)
+  {
+    return slot < layers.size() ? static_cast<u32>(layers[slot]) >> TEXTURE_LAYER_BITS : 0;
+  }
+
+  /**
+   * Per-frame camera, lights and textures data of the material shaders, kept in std140 uniform
+   * blocks at fixed binding points. Changes are recorded on the CPU side, and each changed block
+   * is uploaded with a single call before the next draw, so the cost does not depend on the
+   * number of shaders or draws.
+   */
+  class FrameUniforms
+  {
+  public:
+    static constexpr u32 CAMERA_BINDING = 0;
+    static constexpr u32 LIGHTS_BINDING = 1;
+    static constexpr u32 TEXTURES_BINDING = 2;
+
+    /**
+     * Uniforms shared by the engine, created with the first use of the renderer
+     */
+    static FrameUniforms& Get();
+
+    FrameUniforms();
+
+    void SetCamera(const Mat4& viewProj, const Vec3& viewPosition);
+    void SetAmbientLight(Color color, f32 strength);
+    void SetLightSources(std::span<const LightSource> lightSources);
+
+    /**
+     * Texture array and layer of each texture slot, packed as (array << 16 | layer)
+     */
+    void SetTextureLayers(std::span<const i32> layers);
+    [[nodiscard]] std::span<const i32> GetTextureLayers() const;
+
+    /**
+     * Upload the blocks changed since the last upload
+     */
+    void Upload();
+
+  private:
+    struct CameraBlock
+    {
+      std::array<f32, 16> view_projection;
+      Vec3 view_position;
+      f32 padding;
+    };
+
+    struct LightBlock
+    {
+      Vec3 position;
+      f32 strength;
+      Vec3 color;
+      f32 specular_strength;
+      f32 specular_shininess;
+      std::array<f32, 3> padding;
+    };
+
+    struct LightsBlock
+    {
+      std::array<LightBlock, MAX_LIGHTS> lights;
+      Vec3 ambient_color;
+      f32 ambient_strength;
+      i32 lights_count;
+      std::array<i32, 3> padding;
+    };
+
+    struct TexturesBlock
+    {
+      std::array<i32, MAX_TEXTURE_SLOTS> layers;
+    };
+
+    CameraBlock m_camera{};
+    LightsBlock m_lights{};
+    TexturesBlock m_textures{};
+    bool m_camera_changed = true;
+    bool m_lights_changed = true;
+    bool m_textures_changed = true;
+    Ptr<UniformBuffer> m_camera_buffer;
+    Ptr<UniformBuffer> m_lights_buffer;
+    Ptr<UniformBuffer> m_textures_buffer;
+  };
+}
+
+#endif // GRAPENGINE_GE_FRAME_UNIFORMS_HPP
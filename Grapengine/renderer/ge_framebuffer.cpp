@@ -1,6 +1,7 @@
 #include "renderer/ge_framebuffer.hpp"
 
 #include "profiling/ge_profiler.hpp"
+#include "renderer/ge_gl_state_cache.hpp"
 
 #include <core/ge_assert.hpp>
 #include <glad/glad.h>
@@ -22,6 +23,25 @@ namespace
     return is_fb_bound;
   }
 
+  /**
+   * Attachments grow in steps of this size
+   */
+  constexpr u32 ALLOCATION_STEP = 64;
+
+  u32 RoundUpToStep(u32 size)
+  {
+    return (size + ALLOCATION_STEP - 1) / ALLOCATION_STEP * ALLOCATION_STEP;
+  }
+
+  /**
+   * Attachments are kept while the size fits in them and is at least half of them, so a resize
+   * dragged by the user reallocates only now and then
+   */
+  bool FitsAllocation(Dimensions dim, Dimensions allocated)
+  {
+    return dim.width <= allocated.width && dim.height <= allocated.height &&
+           dim.width * 2 >= allocated.width && dim.height * 2 >= allocated.height;
+  }
 }
 
 Ptr<Framebuffer> Framebuffer::Make(const Dimensions& dimension)
@@ -31,77 +51,45 @@ Ptr<Framebuffer> Framebuffer::Make(const Dimensions& dimension)
 }
 
 Framebuffer::Framebuffer(const Dimensions& dimension) :
-    m_dimension(dimension), m_id(0), m_color_attachment(0), m_depth_attachment(0)
+    m_dimension(dimension),
+    m_allocated({ RoundUpToStep(dimension.width), RoundUpToStep(dimension.height) }),
+    m_id(0),
+    m_color_attachment(0),
+    m_depth_attachment(0)
 {
   GE_PROFILE;
+  u32 fb_id = 0;
+  glCreateFramebuffers(1, &fb_id);
+  m_id = RendererID{ fb_id };
   Invalidate();
 }
 
 GE::Framebuffer::~Framebuffer()
 {
   GE_PROFILE;
-  Clear();
+  // Only resizes give the attachments back to the pool, since a destroyed framebuffer is not
+  // expected to come back with the same size
+  const std::array<u32, 2> attachments{ u32(m_color_attachment), u32(m_depth_attachment) };
+  glDeleteTextures(i32(attachments.size()), attachments.data());
+  for (const u32 attachment : attachments)
+    GLStateCache::Get().OnTextureDeleted(attachment);
+
+  const u32 fb_id = u32(m_id);
+  glDeleteFramebuffers(1, &fb_id);
 }
 
 void Framebuffer::Invalidate()
 {
   GE_PROFILE;
-  if (!glIsTexture(u32(m_id)))
-  {
-    Clear();
-  }
-
-  // Create framebuffer
-  {
-    u32 fb_id = 0;
-    glCreateFramebuffers(1, &fb_id);
-    m_id = RendererID{ fb_id };
-  }
+  ReleaseAttachments();
 
-  glBindFramebuffer(GL_FRAMEBUFFER, u32(m_id));
+  m_color_attachment = RenderTargetPool::Get().Acquire(ColorSpec());
+  m_depth_attachment = RenderTargetPool::Get().Acquire(DepthSpec());
+  glNamedFramebufferTexture(u32(m_id), GL_COLOR_ATTACHMENT0, u32(m_color_attachment), 0);
+  glNamedFramebufferTexture(u32(m_id), GL_DEPTH_STENCIL_ATTACHMENT, u32(m_depth_attachment), 0);
 
-  // Create colors texture
-  {
-    u32 tex_id = 0;
-    glCreateTextures(GL_TEXTURE_2D, 1, &tex_id);
-    m_color_attachment = RendererID{ tex_id };
-  }
-  glBindTexture(GL_TEXTURE_2D, u32(m_color_attachment));
-  glTexImage2D(GL_TEXTURE_2D,
-               0,
-               GL_RGBA8,
-               i32(m_dimension.width),
-               i32(m_dimension.height),
-               0,
-               GL_RGBA,
-               GL_UNSIGNED_BYTE,
-               nullptr);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, u32(m_color_attachment), 0);
-
-  // Create depth texture
-  {
-    u32 tex_id = 0;
-    glCreateTextures(GL_TEXTURE_2D, 1, &tex_id);
-    m_depth_attachment = RendererID{ tex_id };
-  }
-  glBindTexture(GL_TEXTURE_2D, u32(m_depth_attachment));
-  glTexStorage2D(GL_TEXTURE_2D,
-                 1,
-                 GL_DEPTH24_STENCIL8,
-                 i32(m_dimension.width),
-                 i32(m_dimension.height));
-  glFramebufferTexture2D(GL_FRAMEBUFFER,
-                         GL_DEPTH_STENCIL_ATTACHMENT,
-                         GL_TEXTURE_2D,
-                         u32(m_depth_attachment),
-                         0);
-
-  GE_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE,
+  GE_ASSERT(glCheckNamedFramebufferStatus(u32(m_id), GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE,
             "Framebuffer is incomplete");
-
-  glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
 void Framebuffer::Bind() const
@@ -128,27 +116,37 @@ const Dimensions& GE::Framebuffer::GetDimension() const
   return m_dimension;
 }
 
+const Dimensions& Framebuffer::GetAllocatedDimension() const
+{
+  return m_allocated;
+}
+
 void GE::Framebuffer::Resize(Dimensions dim)
 {
-  if (dim.IsEmpty())
+  if (dim.IsEmpty() || dim == m_dimension)
     return;
   m_dimension = dim;
+  if (FitsAllocation(dim, m_allocated))
+    return;
+
+  // The attachments go back to the pool under the allocation they were acquired with
+  ReleaseAttachments();
+  m_allocated = { RoundUpToStep(dim.width), RoundUpToStep(dim.height) };
   Invalidate();
 }
 
-void Framebuffer::Clear()
+RenderTargetSpec Framebuffer::ColorSpec() const
 {
-  GE_PROFILE;
-  {
-    const u32 i = u32(m_id);
-    glDeleteFramebuffers(1, &i);
-  }
-  {
-    const u32 i = u32(m_color_attachment);
-    glDeleteTextures(1, &i);
-  }
-  {
-    const u32 i = u32(m_depth_attachment);
-    glDeleteTextures(1, &i);
-  }
+  return { m_allocated, AttachmentFormat::RGBA8, 1 };
+}
+
+RenderTargetSpec Framebuffer::DepthSpec() const
+{
+  return { m_allocated, AttachmentFormat::DEPTH24_STENCIL8, 1 };
+}
+
+void Framebuffer::ReleaseAttachments()
+{
+  RenderTargetPool::Get().Release(ColorSpec(), std::exchange(m_color_attachment, 0));
+  RenderTargetPool::Get().Release(DepthSpec(), std::exchange(m_depth_attachment, 0));
 }
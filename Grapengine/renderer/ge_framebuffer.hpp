@@ -3,10 +3,17 @@
 
 #include "ge_renderer_id.hpp"
 #include "math/ge_vector.hpp"
+#include "renderer/ge_render_target_pool.hpp"
 #include "utils/ge_dimension.hpp"
 
 namespace GE
 {
+  /**
+   * Framebuffer with a color and a depth attachment taken from the RenderTargetPool. The
+   * attachments are allocated larger than the framebuffer, in steps, so resizing only
+   * reallocates them when the size grows past them or drops below half of them. Rendering covers
+   * the framebuffer dimension, from the bottom left corner of the attachments.
+   */
   class Framebuffer
   {
   public:
@@ -15,24 +22,35 @@ namespace GE
     explicit Framebuffer(const Dimensions& dimension);
     ~Framebuffer();
 
+    Framebuffer(const Framebuffer&) = delete;
+    Framebuffer& operator=(const Framebuffer&) = delete;
+
+    /**
+     * Replace the attachments with ones of the allocated dimension
+     */
     void Invalidate();
     void Resize(Dimensions dim);
 
     void Bind() const;
     void Unbind() const;
 
-    //    [[nodiscard]] const FBSpecs& GetSpec() const;
-
     [[nodiscard]] RendererID GetColorAttachmentID() const;
 
     [[nodiscard]] const Dimensions& GetDimension() const;
 
+    /**
+     * Dimension of the attachments, which is at least the framebuffer dimension
+     */
+    [[nodiscard]] const Dimensions& GetAllocatedDimension() const;
+
   private:
-    void Clear();
+    [[nodiscard]] RenderTargetSpec ColorSpec() const;
+    [[nodiscard]] RenderTargetSpec DepthSpec() const;
+
+    void ReleaseAttachments();
 
     Dimensions m_dimension;
-    //    u32 samples = 1;
-    //    bool swap_chain_target = false;
+    Dimensions m_allocated;
     RendererID m_id;
     RendererID m_color_attachment;
     RendererID m_depth_attachment;
@@ -0,0 +1,184 @@
+#include "renderer/ge_gl_state_cache.hpp"
+
+#include <glad/glad.h>
+
+using namespace GE;
+
+namespace
+{
+  /**
+   * Index of the cached binding of the buffer target, if it is cached
+   */
+  Opt<u64> BufferTargetIndex(u32 target)
+  {
+    switch (target)
+    {
+    case GL_ARRAY_BUFFER:
+      return 0;
+    case GL_ELEMENT_ARRAY_BUFFER:
+      return 1;
+    case GL_PIXEL_UNPACK_BUFFER:
+      return 2;
+    default:
+      return std::nullopt;
+    }
+  }
+
+  void SetCapability(u32 capability, bool enabled)
+  {
+    if (enabled)
+      glEnable(capability);
+    else
+      glDisable(capability);
+  }
+}
+
+GLStateCache& GLStateCache::Get()
+{
+  static GLStateCache cache;
+  return cache;
+}
+
+GLStateCache::GLStateCache()
+{
+  Invalidate();
+}
+
+void GLStateCache::UseProgram(u32 program)
+{
+  if (Change(m_program, program))
+    glUseProgram(program);
+}
+
+void GLStateCache::BindVertexArray(u32 vertexArray)
+{
+  if (!Change(m_vertex_array, vertexArray))
+    return;
+  glBindVertexArray(vertexArray);
+  m_buffers.at(BufferTargetIndex(GL_ELEMENT_ARRAY_BUFFER).value()) = UNKNOWN;
+}
+
+void GLStateCache::BindBuffer(u32 target, u32 buffer)
+{
+  const Opt<u64> index = BufferTargetIndex(target);
+  if (!index.has_value())
+  {
+    m_stats.calls++;
+    glBindBuffer(target, buffer);
+    return;
+  }
+  if (Change(m_buffers.at(index.value()), buffer))
+    glBindBuffer(target, buffer);
+}
+
+void GLStateCache::BindTextureUnit(u32 unit, u32 texture)
+{
+  if (unit >= TEXTURE_UNITS)
+  {
+    m_stats.calls++;
+    glBindTextureUnit(unit, texture);
+    return;
+  }
+  if (Change(m_textures.at(unit), texture))
+    glBindTextureUnit(unit, texture);
+}
+
+void GLStateCache::SetBlend(bool enabled)
+{
+  if (Change(m_blend, u32(enabled)))
+    SetCapability(GL_BLEND, enabled);
+}
+
+void GLStateCache::SetBlendFunc(u32 source, u32 destination)
+{
+  m_stats.calls++;
+  if (m_blend_source == source && m_blend_destination == destination)
+  {
+    m_stats.calls_avoided++;
+    return;
+  }
+  m_blend_source = source;
+  m_blend_destination = destination;
+  glBlendFunc(source, destination);
+}
+
+void GLStateCache::SetDepthTest(bool enabled)
+{
+  if (Change(m_depth_test, u32(enabled)))
+    SetCapability(GL_DEPTH_TEST, enabled);
+}
+
+void GLStateCache::SetDepthFunc(u32 func)
+{
+  if (Change(m_depth_func, func))
+    glDepthFunc(func);
+}
+
+void GLStateCache::SetDepthMask(bool enabled)
+{
+  if (Change(m_depth_mask, u32(enabled)))
+    glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+}
+
+u32 GLStateCache::GetProgram() const
+{
+  return m_program;
+}
+
+u32 GLStateCache::GetVertexArray() const
+{
+  return m_vertex_array;
+}
+
+void GLStateCache::OnProgramDeleted(u32 program)
+{
+  if (m_program == program)
+    m_program = UNKNOWN;
+}
+
+void GLStateCache::OnVertexArrayDeleted(u32 vertexArray)
+{
+  if (m_vertex_array == vertexArray)
+    m_vertex_array = UNKNOWN;
+}
+
+void GLStateCache::OnBufferDeleted(u32 buffer)
+{
+  std::ranges::replace(m_buffers, buffer, UNKNOWN);
+}
+
+void GLStateCache::OnTextureDeleted(u32 texture)
+{
+  std::ranges::replace(m_textures, texture, UNKNOWN);
+}
+
+void GLStateCache::Invalidate()
+{
+  m_program = UNKNOWN;
+  m_vertex_array = UNKNOWN;
+  m_buffers.fill(UNKNOWN);
+  m_textures.fill(UNKNOWN);
+  m_blend = UNKNOWN;
+  m_blend_source = UNKNOWN;
+  m_blend_destination = UNKNOWN;
+  m_depth_test = UNKNOWN;
+  m_depth_func = UNKNOWN;
+  m_depth_mask = UNKNOWN;
+}
+
+GLStateCache::Statistics GLStateCache::TakeStatistics()
+{
+  return std::exchange(m_stats, Statistics{});
+}
+
+bool GLStateCache::Change(u32& cached, u32 value)
+{
+  m_stats.calls++;
+  if (cached == value)
+  {
+    m_stats.calls_avoided++;
+    return false;
+  }
+  cached = value;
+  return true;
+}
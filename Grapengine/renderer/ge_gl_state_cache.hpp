@@ -0,0 +1,86 @@
+#ifndef GRAPENGINE_GE_GL_STATE_CACHE_HPP
+#define GRAPENGINE_GE_GL_STATE_CACHE_HPP
+
+namespace GE
+{
+  /**
+   * Cache of the OpenGL bindings and render state set by the engine, so that setting a value
+   * that is already current skips the GL call. The engine changes this state only through the
+   * cache; code that changes it behind the cache must call Invalidate.
+   */
+  class GLStateCache
+  {
+  public:
+    static constexpr u32 TEXTURE_UNITS = 32;
+
+    struct Statistics
+    {
+      u64 calls = 0;
+      u64 calls_avoided = 0;
+    };
+
+    static GLStateCache& Get();
+
+    GLStateCache();
+
+    void UseProgram(u32 program);
+    void BindVertexArray(u32 vertexArray);
+
+    /**
+     * Bind a buffer to a target. The element array binding belongs to the vertex array, so it is
+     * forgotten whenever another vertex array is bound.
+     */
+    void BindBuffer(u32 target, u32 buffer);
+    void BindTextureUnit(u32 unit, u32 texture);
+
+    void SetBlend(bool enabled);
+    void SetBlendFunc(u32 source, u32 destination);
+    void SetDepthTest(bool enabled);
+    void SetDepthFunc(u32 func);
+    void SetDepthMask(bool enabled);
+
+    [[nodiscard]] u32 GetProgram() const;
+    [[nodiscard]] u32 GetVertexArray() const;
+
+    /**
+     * Deleted objects are unbound by GL and their names may be reused, so the cache must not
+     * keep them
+     */
+    void OnProgramDeleted(u32 program);
+    void OnVertexArrayDeleted(u32 vertexArray);
+    void OnBufferDeleted(u32 buffer);
+    void OnTextureDeleted(u32 texture);
+
+    /**
+     * Forget every cached value, so the next change of each state calls GL
+     */
+    void Invalidate();
+
+    /**
+     * Calls requested since the last call, which resets them
+     */
+    Statistics TakeStatistics();
+
+  private:
+    static constexpr u32 UNKNOWN = std::numeric_limits<u32>::max();
+
+    /**
+     * Store the value and tell whether it differs from the cached one, counting the call
+     */
+    bool Change(u32& cached, u32 value);
+
+    u32 m_program = UNKNOWN;
+    u32 m_vertex_array = UNKNOWN;
+    std::array<u32, 3> m_buffers{};
+    std::array<u32, TEXTURE_UNITS> m_textures{};
+    u32 m_blend = UNKNOWN;
+    u32 m_blend_source = UNKNOWN;
+    u32 m_blend_destination = UNKNOWN;
+    u32 m_depth_test = UNKNOWN;
+    u32 m_depth_func = UNKNOWN;
+    u32 m_depth_mask = UNKNOWN;
+    Statistics m_stats;
+  };
+}
+
+#endif // GRAPENGINE_GE_GL_STATE_CACHE_HPP
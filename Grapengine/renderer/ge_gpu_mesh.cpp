@@ -0,0 +1,49 @@
+#include "renderer/ge_gpu_mesh.hpp"
+
+#include "profiling/ge_profiler.hpp"
+
+#include <glad/glad.h>
+
+using namespace GE;
+
+BufferLayout GPUMesh::GetInstanceLayout()
+{
+  return BufferLayout{ BufferLayout::BuildElementsList({
+    DataPurpose::MODEL_MATRIX_F16,
+    DataPurpose::NORMAL_MATRIX_F9,
+    DataPurpose::COLOR_RGBA8,
+    DataPurpose::TEX_ID_INT,
+  }) };
+}
+
+GPUMesh::GPUMesh(const VerticesData& vertices, const std::vector<u32>& indices) :
+    m_indices_count(static_cast<i32>(indices.size()))
+{
+  GE_PROFILE;
+  m_vao = VertexArray::Make();
+  m_vao->Bind();
+
+  const std::vector<PackedVertexStruct> packed = vertices.GetPacked();
+  m_vbo = VertexBuffer::Make(packed.data(),
+                             packed.size() * sizeof(PackedVertexStruct),
+                             m_vao->GetID());
+  m_vao->SetVertexBuffer(m_vbo, VerticesData::GetLayout());
+
+  m_ibo = IndexBuffer::Make(indices, m_vao->GetID());
+  m_vao->SetIndexBuffer(m_ibo);
+
+  m_instances_vbo = VertexBuffer::Make(nullptr, 0, m_vao->GetID());
+  m_vao->SetInstanceBuffer(m_instances_vbo, GetInstanceLayout());
+}
+
+void GPUMesh::DrawInstances(const std::vector<InstanceStruct>& instances) const
+{
+  GE_PROFILE;
+  m_vao->Bind();
+  m_instances_vbo->UpdateData(instances.data(), instances.size() * sizeof(InstanceStruct));
+  glDrawElementsInstanced(GL_TRIANGLES,
+                          m_indices_count,
+                          GL_UNSIGNED_INT,
+                          nullptr,
+                          static_cast<i32>(instances.size()));
+}
@@ -0,0 +1,36 @@
+#ifndef GRAPENGINE_GE_GPU_MESH_HPP
+#define GRAPENGINE_GE_GPU_MESH_HPP
+
+#include "renderer/ge_index_buffer.hpp"
+#include "renderer/ge_vertex_array.hpp"
+#include "renderer/ge_vertex_buffer.hpp"
+#include "renderer/ge_vertices_data.hpp"
+
+namespace GE
+{
+  /**
+   * Geometry uploaded once to GPU-resident buffers, drawn many times with a buffer of
+   * per-instance attributes
+   */
+  class GPUMesh
+  {
+  public:
+    [[nodiscard]] static BufferLayout GetInstanceLayout();
+
+    GPUMesh(const VerticesData& vertices, const std::vector<u32>& indices);
+
+    /**
+     * Upload the instances and draw all of them with a single instanced draw call
+     */
+    void DrawInstances(const std::vector<InstanceStruct>& instances) const;
+
+  private:
+    Ptr<VertexArray> m_vao;
+    Ptr<VertexBuffer> m_vbo;
+    Ptr<IndexBuffer> m_ibo;
+    Ptr<VertexBuffer> m_instances_vbo;
+    i32 m_indices_count;
+  };
+}
+
+#endif // GRAPENGINE_GE_GPU_MESH_HPP
@@ -0,0 +1,197 @@
+#include "renderer/ge_image.hpp"
+
+#include "core/ge_assert.hpp"
+#include "core/ge_platform.hpp"
+#include "profiling/ge_profiler.hpp"
+#include "utils/ge_io.hpp"
+
+// clang-format off
+#define STB_IMAGE_IMPLEMENTATION
+#if defined(GE_GCC_COMPILER) && (__GNUC__ <= 12)
+#define STBI_NO_SIMD
+#endif
+#include <stb_image.h>
+// clang-format on
+
+#include <cstring>
+
+using namespace GE;
+
+namespace
+{
+  constexpr i32 RGBA_CHANNELS = 4;
+  constexpr u32 BLOCK_SIZE = 4;
+
+  // Layout of the DDS files, the magic number followed by the header and, for formats without
+  // a FourCC, the DX10 header
+  constexpr u32 DDS_MAGIC = 0x20534444; // "DDS "
+  constexpr u64 DDS_HEADER_OFFSET = 4;
+  constexpr u64 DDS_HEADER_SIZE = 124;
+  constexpr u64 DDS_HEIGHT_OFFSET = DDS_HEADER_OFFSET + 8;
+  constexpr u64 DDS_WIDTH_OFFSET = DDS_HEADER_OFFSET + 12;
+  constexpr u64 DDS_MIP_COUNT_OFFSET = DDS_HEADER_OFFSET + 24;
+  constexpr u64 DDS_FOURCC_OFFSET = DDS_HEADER_OFFSET + 80;
+  constexpr u64 DDS_DX10_HEADER_SIZE = 20;
+  constexpr u32 FOURCC_DXT1 = 0x31545844; // "DXT1"
+  constexpr u32 FOURCC_DXT5 = 0x35545844; // "DXT5"
+  constexpr u32 FOURCC_DX10 = 0x30315844; // "DX10"
+  constexpr u32 DXGI_FORMAT_BC1_UNORM = 71;
+  constexpr u32 DXGI_FORMAT_BC3_UNORM = 77;
+  constexpr u32 DXGI_FORMAT_BC7_UNORM = 98;
+
+  u32 ReadU32(std::string_view data, u64 offset)
+  {
+    u32 value = 0;
+    std::memcpy(&value, data.data() + offset, sizeof(u32));
+    return value;
+  }
+
+  Opt<PixelFormat> GetDDSFormat(u32 fourCC, u32 dxgiFormat)
+  {
+    if (fourCC == FOURCC_DXT1)
+      return PixelFormat::BC1;
+    if (fourCC == FOURCC_DXT5)
+      return PixelFormat::BC3;
+    if (fourCC != FOURCC_DX10)
+      return std::nullopt;
+
+    // The sRGB variants follow each UNORM one
+    if (dxgiFormat == DXGI_FORMAT_BC1_UNORM || dxgiFormat == DXGI_FORMAT_BC1_UNORM + 1)
+      return PixelFormat::BC1;
+    if (dxgiFormat == DXGI_FORMAT_BC3_UNORM || dxgiFormat == DXGI_FORMAT_BC3_UNORM + 1)
+      return PixelFormat::BC3;
+    if (dxgiFormat == DXGI_FORMAT_BC7_UNORM || dxgiFormat == DXGI_FORMAT_BC7_UNORM + 1)
+      return PixelFormat::BC7;
+    return std::nullopt;
+  }
+
+  Image DecodeDDS(std::string_view data, const std::filesystem::path& path)
+  {
+    GE_PROFILE;
+    GE_ASSERT_OR_RETURN(data.size() >= DDS_HEADER_OFFSET + DDS_HEADER_SIZE &&
+                          ReadU32(data, 0) == DDS_MAGIC,
+                        {},
+                        "Invalid DDS file: {}",
+                        path.string());
+
+    const u32 fourcc = ReadU32(data, DDS_FOURCC_OFFSET);
+    u64 offset = DDS_HEADER_OFFSET + DDS_HEADER_SIZE;
+    u32 dxgi_format = 0;
+    if (fourcc == FOURCC_DX10)
+    {
+      GE_ASSERT_OR_RETURN(
+        data.size() >= offset + DDS_DX10_HEADER_SIZE, {}, "Invalid DDS file: {}", path.string());
+      dxgi_format = ReadU32(data, offset);
+      offset += DDS_DX10_HEADER_SIZE;
+    }
+
+    const Opt<PixelFormat> format = GetDDSFormat(fourcc, dxgi_format);
+    GE_ASSERT_OR_RETURN(
+      format.has_value(), {}, "DDS file not in BC1, BC3 or BC7: {}", path.string());
+
+    Image image{ { ReadU32(data, DDS_WIDTH_OFFSET), ReadU32(data, DDS_HEIGHT_OFFSET) },
+                 {},
+                 format.value(),
+                 std::max(ReadU32(data, DDS_MIP_COUNT_OFFSET), 1u) };
+    image.levels = std::min(image.levels, Image::MipLevelsCount(image.dimension));
+
+    u64 size = 0;
+    for (u32 level = 0; level < image.levels; level++)
+      size += Image::LevelSize(image.format, image.dimension, level);
+    GE_ASSERT_OR_RETURN(
+      data.size() >= offset + size, {}, "Truncated DDS file: {}", path.string());
+
+    image.pixels.assign(data.begin() + i64(offset), data.begin() + i64(offset + size));
+    return image;
+  }
+}
+
+Image Image::Load(const std::filesystem::path& path)
+{
+  GE_PROFILE;
+  GE_ASSERT(std::filesystem::exists(path), "File not found at: {}", path.string());
+  return Decode(IO::ReadFileToString(path), path);
+}
+
+Image Image::Decode(std::string_view data, const std::filesystem::path& path)
+{
+  GE_PROFILE;
+  if (IsDDS(path))
+    return DecodeDDS(data, path);
+
+  // Images are decoded by several threads at once
+  stbi_set_flip_vertically_on_load_thread(1);
+  i32 w{};
+  i32 h{};
+  i32 channels{};
+  stbi_uc* pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(data.data()),
+                                          i32(data.size()),
+                                          &w,
+                                          &h,
+                                          &channels,
+                                          RGBA_CHANNELS);
+  if (pixels == nullptr)
+  {
+    GE_ASSERT(false, "Failure at decoding the image: {}", path.string());
+    return {};
+  }
+
+  Image image{ Dimensions{ u32(w), u32(h) }, {}, PixelFormat::RGBA8, 1 };
+  image.pixels.assign(pixels, pixels + u64(w) * u64(h) * RGBA_CHANNELS);
+  stbi_image_free(pixels);
+  return image;
+}
+
+bool Image::IsDDS(const std::filesystem::path& path)
+{
+  return path.extension() == ".dds";
+}
+
+Image Image::White()
+{
+  return Image{ Dimensions{ 1, 1 }, { 0xFF, 0xFF, 0xFF, 0xFF }, PixelFormat::RGBA8, 1 };
+}
+
+u32 Image::MipLevelsCount(Dimensions dimension)
+{
+  return u32(std::bit_width(std::max(dimension.width, dimension.height)));
+}
+
+Dimensions Image::LevelDimension(Dimensions dimension, u32 level)
+{
+  return { std::max(dimension.width >> level, 1u), std::max(dimension.height >> level, 1u) };
+}
+
+u64 Image::LevelSize(PixelFormat format, Dimensions dimension, u32 level)
+{
+  const auto [width, height] = LevelDimension(dimension, level);
+  const u64 blocks =
+    u64((width + BLOCK_SIZE - 1) / BLOCK_SIZE) * u64((height + BLOCK_SIZE - 1) / BLOCK_SIZE);
+  switch (format)
+  {
+  case PixelFormat::RGBA8:
+    return u64(width) * u64(height) * RGBA_CHANNELS;
+  case PixelFormat::BC1:
+    return blocks * 8;
+  case PixelFormat::BC3:
+  case PixelFormat::BC7:
+    return blocks * 16;
+  }
+  Platform::Unreachable();
+}
+
+std::string_view Image::FormatName(PixelFormat format)
+{
+  switch (format)
+  {
+  case PixelFormat::RGBA8:
+    return "RGBA8";
+  case PixelFormat::BC1:
+    return "BC1";
+  case PixelFormat::BC3:
+    return "BC3";
+  case PixelFormat::BC7:
+    return "BC7";
+  }
+  Platform::Unreachable();
+}
@@ -0,0 +1,73 @@
+#ifndef GRAPENGINE_GE_IMAGE_HPP
+#define GRAPENGINE_GE_IMAGE_HPP
+
+#include "utils/ge_dimension.hpp"
+
+#include <filesystem>
+
+namespace GE
+{
+  /**
+   * Layout of the pixels of an image, uncompressed or in blocks of 4x4 pixels
+   */
+  enum class PixelFormat : u8
+  {
+    RGBA8,
+    BC1,
+    BC3,
+    BC7
+  };
+
+  /**
+   * Decoded image with the rows from bottom to top as OpenGL expects them. Images decoded from
+   * PNG or JPEG are in RGBA8 with a single level, while DDS files keep their block-compressed
+   * format and mip levels, stored one after the other from the largest. Compressed images are
+   * not flipped, so their files must be authored bottom to top.
+   */
+  struct Image
+  {
+    Dimensions dimension{};
+    std::vector<u8> pixels;
+    PixelFormat format = PixelFormat::RGBA8;
+    u32 levels = 1;
+
+    /**
+     * Decode an image file, which is empty when the file cannot be decoded
+     */
+    static Image Load(const std::filesystem::path& path);
+
+    /**
+     * Decode the content of an image file, the path telling its type
+     */
+    static Image Decode(std::string_view data, const std::filesystem::path& path);
+
+    /**
+     * Whether the file is read as it is stored, without decoding
+     */
+    static bool IsDDS(const std::filesystem::path& path);
+
+    /**
+     * Single white pixel, the texture of untextured objects
+     */
+    static Image White();
+
+    /**
+     * Number of levels of the complete mip chain of the dimension, down to 1x1
+     */
+    static u32 MipLevelsCount(Dimensions dimension);
+
+    static Dimensions LevelDimension(Dimensions dimension, u32 level);
+
+    /**
+     * Bytes of a level in the format, the first level being the dimension
+     */
+    static u64 LevelSize(PixelFormat format, Dimensions dimension, u32 level);
+
+    static std::string_view FormatName(PixelFormat format);
+
+    [[nodiscard]] bool IsEmpty() const { return pixels.empty(); }
+    [[nodiscard]] bool IsCompressed() const { return format != PixelFormat::RGBA8; }
+  };
+}
+
+#endif // GRAPENGINE_GE_IMAGE_HPP
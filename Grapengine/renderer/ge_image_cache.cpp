@@ -0,0 +1,148 @@
+#include "renderer/ge_image_cache.hpp"
+
+#include "core/ge_assert.hpp"
+#include "profiling/ge_profiler.hpp"
+#include "utils/ge_io.hpp"
+
+using namespace GE;
+
+namespace
+{
+  constexpr u32 ENTRY_MAGIC = 0x47454943; // "CIEG"
+  constexpr u32 ENTRY_VERSION = 1;
+
+  /**
+   * Start of each cache entry, followed by the pixels
+   */
+  struct EntryHeader
+  {
+    u32 magic;
+    u32 version;
+    u32 width;
+    u32 height;
+    u32 format;
+    u32 levels;
+    u64 size;
+  };
+
+  /**
+   * Whether the header describes an image, so a corrupted entry is decoded again
+   */
+  bool IsValid(const EntryHeader& header)
+  {
+    if (header.magic != ENTRY_MAGIC || header.version != ENTRY_VERSION ||
+        header.format > static_cast<u32>(PixelFormat::BC7) || header.levels == 0)
+      return false;
+
+    const Dimensions dimension{ header.width, header.height };
+    if (dimension.IsEmpty() || header.levels > Image::MipLevelsCount(dimension))
+      return false;
+
+    u64 size = 0;
+    for (u32 level = 0; level < header.levels; level++)
+      size += Image::LevelSize(static_cast<PixelFormat>(header.format), dimension, level);
+    return size == header.size;
+  }
+}
+
+ImageCache& ImageCache::Get()
+{
+  static ImageCache cache{ std::filesystem::temp_directory_path() / "grapengine" / "images" };
+  return cache;
+}
+
+ImageCache::ImageCache(std::filesystem::path directory) : m_directory(std::move(directory)) {}
+
+Image ImageCache::Load(const std::filesystem::path& path) const
+{
+  GE_PROFILE;
+  GE_ASSERT(std::filesystem::exists(path), "File not found at: {}", path.string());
+  const std::string data = IO::ReadFileToString(path);
+  // Compressed files are already uploaded as they are stored
+  if (Image::IsDDS(path))
+    return Image::Decode(data, path);
+
+  const std::filesystem::path entry = GetEntryPath(Hash(data));
+  if (Opt<Image> cached = Read(entry); cached.has_value())
+    return std::move(cached.value());
+
+  Image image = Image::Decode(data, path);
+  if (!image.IsEmpty())
+    Write(entry, image);
+  return image;
+}
+
+u64 ImageCache::Hash(std::string_view data)
+{
+  u64 hash = 14695981039346656037ULL;
+  for (const char c : data)
+  {
+    hash ^= static_cast<u8>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+std::filesystem::path ImageCache::GetEntryPath(u64 hash) const
+{
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << hash << ".image";
+  return m_directory / name.str();
+}
+
+Opt<Image> ImageCache::Read(const std::filesystem::path& entry)
+{
+  GE_PROFILE;
+  std::ifstream file{ entry, std::ios::binary };
+  if (!file.is_open())
+    return std::nullopt;
+
+  EntryHeader header{};
+  file.read(reinterpret_cast<char*>(&header), sizeof(EntryHeader));
+  if (!file || !IsValid(header))
+    return std::nullopt;
+
+  Image image{ { header.width, header.height },
+               std::vector<u8>(header.size),
+               static_cast<PixelFormat>(header.format),
+               header.levels };
+  file.read(reinterpret_cast<char*>(image.pixels.data()), static_cast<i64>(header.size));
+  if (!file)
+    return std::nullopt;
+  return image;
+}
+
+void ImageCache::Write(const std::filesystem::path& entry, const Image& image)
+{
+  GE_PROFILE;
+  std::error_code error;
+  std::filesystem::create_directories(entry.parent_path(), error);
+
+  // Written aside and renamed, so other threads or launches never read a partial entry
+  std::ostringstream temp_name;
+  temp_name << entry.filename().string() << '.' << std::this_thread::get_id() << ".tmp";
+  const std::filesystem::path temp = entry.parent_path() / temp_name.str();
+  {
+    std::ofstream file{ temp, std::ios::binary };
+    const EntryHeader header{ ENTRY_MAGIC,
+                              ENTRY_VERSION,
+                              image.dimension.width,
+                              image.dimension.height,
+                              static_cast<u32>(image.format),
+                              image.levels,
+                              image.pixels.size() };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(EntryHeader));
+    file.write(reinterpret_cast<const char*>(image.pixels.data()),
+               static_cast<i64>(image.pixels.size()));
+    if (!file)
+    {
+      GE_WARN("Failure at writing the image cache entry {}", temp.string())
+      file.close();
+      std::filesystem::remove(temp, error);
+      return;
+    }
+  }
+  std::filesystem::rename(temp, entry, error);
+  if (error)
+    std::filesystem::remove(temp, error);
+}
@@ -0,0 +1,43 @@
+#ifndef GRAPENGINE_GE_IMAGE_CACHE_HPP
+#define GRAPENGINE_GE_IMAGE_CACHE_HPP
+
+#include "renderer/ge_image.hpp"
+
+namespace GE
+{
+  /**
+   * Decoded images stored on disk, keyed by a hash of the content of their files, so an image
+   * decoded once is only read on the next launches. A file changed since it was cached has
+   * another key and is decoded again. The cache is used by several threads at once.
+   */
+  class ImageCache
+  {
+  public:
+    /**
+     * Cache shared by the engine, in the temporary directory of the system
+     */
+    static ImageCache& Get();
+
+    explicit ImageCache(std::filesystem::path directory);
+
+    /**
+     * Image of the file, read from the cache when the same content was decoded before, and
+     * decoded and cached otherwise
+     */
+    [[nodiscard]] Image Load(const std::filesystem::path& path) const;
+
+    /**
+     * 64-bit FNV-1a hash of the content of a file
+     */
+    static u64 Hash(std::string_view data);
+
+  private:
+    [[nodiscard]] std::filesystem::path GetEntryPath(u64 hash) const;
+    [[nodiscard]] static Opt<Image> Read(const std::filesystem::path& entry);
+    static void Write(const std::filesystem::path& entry, const Image& image);
+
+    std::filesystem::path m_directory;
+  };
+}
+
+#endif // GRAPENGINE_GE_IMAGE_CACHE_HPP
@@ -14,11 +14,15 @@ namespace GE
 
     void Bind() const;
 
-    void UpdateData(const std::vector<u32>& indices) const;
+    /**
+     * Replace the indices, reallocating the storage only when it must grow
+     */
+    void UpdateData(const std::vector<u32>& indices);
 
   private:
     RendererID m_id;
     RendererID m_parent;
+    u64 m_capacity;
   };
 }
 #endif // GRAPENGINE_INDEX_BUFFER_HPP
@@ -0,0 +1,182 @@
+#include "renderer/ge_instance_renderer.hpp"
+
+#include "profiling/ge_profiler.hpp"
+#include "renderer/ge_buffer_handler.hpp"
+
+using namespace GE;
+
+namespace
+{
+  template <typename T>
+  void HashCombine(u64& seed, const T& value)
+  {
+    constexpr u64 GOLDEN_RATIO = 0x9e3779b97f4a7c15ULL;
+    seed ^= std::hash<T>{}(value) + GOLDEN_RATIO + (seed << 6) + (seed >> 2);
+  }
+
+  u64 HashGeometry(const VerticesData& vertices, const std::vector<u32>& indices)
+  {
+    u64 seed = vertices.GetCount();
+    for (const VertexStruct& vs : vertices.GetData())
+    {
+      for (f32 f : { vs.position.x, vs.position.y, vs.position.z })
+        HashCombine(seed, f);
+      for (f32 f : { vs.texture_coord.x, vs.texture_coord.y })
+        HashCombine(seed, f);
+      for (f32 f : { vs.normal.x, vs.normal.y, vs.normal.z })
+        HashCombine(seed, f);
+    }
+    for (u32 i : indices)
+      HashCombine(seed, i);
+    return seed;
+  }
+
+  bool IsSameGeometry(const VerticesData& lhs, const VerticesData& rhs)
+  {
+    return std::ranges::equal(lhs.GetData(),
+                              rhs.GetData(),
+                              [](const VertexStruct& l, const VertexStruct& r)
+                              {
+                                return l.position == r.position &&
+                                       l.texture_coord == r.texture_coord &&
+                                       l.normal == r.normal;
+                              });
+  }
+
+  InstanceStruct MakeInstance(const Mat4& modelMat, Color color, u32 texSlot)
+  {
+    InstanceStruct instance{};
+    std::copy_n(modelMat.ValuePtr(), instance.model.size(), instance.model.begin());
+
+    const Mat3 normal_matrix = BufferHandler::NormalMatrix(modelMat);
+    for (u32 col = 0; col < 3; col++)
+    {
+      for (u32 row = 0; row < 3; row++)
+        instance.normal_matrix.at(col * 3 + row) = normal_matrix(row, col);
+    }
+
+    instance.color = { color.R(), color.G(), color.B(), color.A() };
+    instance.texture_slot = static_cast<i32>(texSlot);
+    return instance;
+  }
+}
+
+u32 InstanceRenderer::AcquireMesh(const Drawable& drawable)
+{
+  GE_PROFILE;
+  const u64 geometry_id = drawable.GetGeometryId();
+  if (auto it = m_meshes_by_geometry.find(geometry_id); it != m_meshes_by_geometry.end())
+  {
+    m_meshes[it->second].references++;
+    return it->second;
+  }
+
+  // Drawables built apart may still have the same geometry
+  const VerticesData& vertices = drawable.GetVerticesData();
+  const std::vector<u32>& indices = drawable.GetIndicesData();
+  const u64 hash = HashGeometry(vertices, indices);
+  Opt<u32> found;
+  auto [begin, end] = m_meshes_by_hash.equal_range(hash);
+  for (auto it = begin; it != end && !found; ++it)
+  {
+    const MeshEntry& entry = m_meshes[it->second];
+    if (entry.indices == indices && IsSameGeometry(entry.vertices, vertices))
+      found = it->second;
+  }
+
+  u32 id = 0;
+  if (found)
+  {
+    id = found.value();
+  }
+  else
+  {
+    if (m_free_meshes.empty())
+    {
+      id = static_cast<u32>(m_meshes.size());
+      m_meshes.emplace_back();
+    }
+    else
+    {
+      id = m_free_meshes.back();
+      m_free_meshes.pop_back();
+    }
+    MeshEntry& entry = m_meshes[id];
+    entry.hash = hash;
+    entry.vertices = vertices;
+    entry.indices = indices;
+    entry.gpu_mesh = MakeScope<GPUMesh>(vertices, indices);
+    m_meshes_by_hash.emplace(hash, id);
+  }
+
+  MeshEntry& entry = m_meshes[id];
+  entry.references++;
+  if (geometry_id != 0)
+  {
+    entry.geometry_ids.push_back(geometry_id);
+    m_meshes_by_geometry.emplace(geometry_id, id);
+  }
+  return id;
+}
+
+void InstanceRenderer::ReleaseMesh(u32 mesh)
+{
+  GE_PROFILE;
+  GE_ASSERT_OR_RETURN_VOID(mesh < m_meshes.size() && m_meshes[mesh].references > 0,
+                           "Mesh {} not acquired",
+                           mesh);
+  MeshEntry& entry = m_meshes[mesh];
+  if (--entry.references > 0)
+    return;
+
+  for (u64 geometry_id : entry.geometry_ids)
+    m_meshes_by_geometry.erase(geometry_id);
+  entry.geometry_ids.clear();
+  auto [begin, end] = m_meshes_by_hash.equal_range(entry.hash);
+  m_meshes_by_hash.erase(
+    std::find_if(begin, end, [&](const auto& pair) { return pair.second == mesh; }));
+
+  // The slot keeps its instance vectors to reuse their capacity
+  entry.vertices = VerticesData();
+  entry.indices.clear();
+  entry.gpu_mesh.reset();
+  m_free_meshes.push_back(mesh);
+}
+
+void InstanceRenderer::Begin(std::span<const i32> textureLayers)
+{
+  m_texture_layers.assign(textureLayers.begin(), textureLayers.end());
+  for (MeshEntry& entry : m_meshes)
+  {
+    for (std::vector<InstanceStruct>& instances : entry.instances)
+      instances.clear();
+  }
+}
+
+void InstanceRenderer::PushInstance(u32 mesh, const Mat4& modelMat, Color color, u32 texSlot)
+{
+  GE_ASSERT(mesh < m_meshes.size() && m_meshes[mesh].references > 0, "Mesh {} not acquired", mesh);
+  const u32 texture_array = TextureArrayOf(m_texture_layers, texSlot);
+  GE_ASSERT_OR_RETURN_VOID(texture_array < MAX_TEXTURE_ARRAYS, "Texture array out of range");
+  m_meshes[mesh].instances.at(texture_array).push_back(MakeInstance(modelMat, color, texSlot));
+}
+
+void InstanceRenderer::End(IShaderProgram& shader)
+{
+  GE_PROFILE;
+  for (const MeshEntry& entry : m_meshes)
+  {
+    if (entry.gpu_mesh == nullptr)
+      continue;
+
+    for (u32 texture_array = 0; texture_array < MAX_TEXTURE_ARRAYS; texture_array++)
+    {
+      const std::vector<InstanceStruct>& instances = entry.instances.at(texture_array);
+      if (instances.empty())
+        continue;
+
+      shader.UpdateTexture(static_cast<i32>(texture_array));
+      entry.gpu_mesh->DrawInstances(instances);
+    }
+  }
+}
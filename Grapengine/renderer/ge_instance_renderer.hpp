@@ -0,0 +1,70 @@
+#ifndef GRAPENGINE_GE_INSTANCE_RENDERER_HPP
+#define GRAPENGINE_GE_INSTANCE_RENDERER_HPP
+
+#include "drawables/ge_color.hpp"
+#include "drawables/ge_drawable.hpp"
+#include "renderer/ge_frame_uniforms.hpp"
+#include "renderer/ge_gpu_mesh.hpp"
+#include "renderer/ge_ishader_program.hpp"
+
+namespace GE
+{
+  /**
+   * Renderer of drawables that share their geometry.
+   * Each distinct geometry is uploaded once as a GPU mesh, and every object that uses it becomes
+   * an instance with its own model matrix, color and texture, so the work done each frame is
+   * proportional to the amount of instances instead of vertices.
+   * Instances of a mesh are grouped by the texture array of their slot, a draw for each group.
+   */
+  class InstanceRenderer
+  {
+  public:
+    /**
+     * Add a reference to the mesh with the geometry of the drawable, uploading it when it is new.
+     * Meshes are looked up by the geometry id of the drawable, and only drawables with an id
+     * not seen yet are compared by their geometry.
+     * Colors and texture slots of the vertices are not part of the geometry
+     * @param drawable drawable whose geometry is looked up
+     * @return mesh id
+     */
+    u32 AcquireMesh(const Drawable& drawable);
+
+    /**
+     * Remove a reference to the mesh, which is freed with its last reference
+     * @param mesh mesh id returned by AcquireMesh
+     */
+    void ReleaseMesh(u32 mesh);
+
+    /**
+     * @param textureLayers texture array and layer of each texture slot, as in FrameUniforms
+     */
+    void Begin(std::span<const i32> textureLayers);
+
+    void PushInstance(u32 mesh, const Mat4& modelMat, Color color, u32 texSlot);
+
+    /**
+     * Draw the instances with the active shader, which is told the texture array of each draw
+     */
+    void End(IShaderProgram& shader);
+
+  private:
+    struct MeshEntry
+    {
+      u64 hash = 0;
+      VerticesData vertices;
+      std::vector<u32> indices;
+      Scope<GPUMesh> gpu_mesh;
+      std::array<std::vector<InstanceStruct>, MAX_TEXTURE_ARRAYS> instances;
+      u32 references = 0;
+      std::vector<u64> geometry_ids;
+    };
+
+    std::vector<i32> m_texture_layers;
+    std::vector<MeshEntry> m_meshes;
+    std::vector<u32> m_free_meshes;
+    std::unordered_multimap<u64, u32> m_meshes_by_hash;
+    std::unordered_map<u64, u32> m_meshes_by_geometry;
+  };
+}
+
+#endif // GRAPENGINE_GE_INSTANCE_RENDERER_HPP
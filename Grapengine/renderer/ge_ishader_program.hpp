@@ -15,14 +15,31 @@ namespace GE
     u32 texture_slot;
 
     bool operator==(const VertexStruct& other) const = default;
-    auto operator<=>(const VertexStruct& other) const
-    {
-      if (color.x3 < other.color.x3)
-        return 1;
-      if (color.x3 > other.color.x3)
-        return -1;
-      return 0;
-    }
+  };
+
+  /**
+   * Vertex as uploaded to the GPU, with half-float texture coordinates, RGBA8 color, the normal
+   * as signed normalized 10-10-10-2 and a 16-bit texture slot
+   */
+  struct PackedVertexStruct
+  {
+    Vec3 position;
+    std::array<u16, 2> texture_coord;
+    std::array<u8, 4> color;
+    u32 normal;
+    u16 texture_slot;
+    u16 padding;
+  };
+
+  /**
+   * Per-instance attributes, with matrices in column-major order and color as RGBA8
+   */
+  struct InstanceStruct
+  {
+    std::array<f32, 16> model;
+    std::array<f32, 9> normal_matrix;
+    std::array<u8, 4> color;
+    i32 texture_slot;
   };
 
   class IShaderProgram
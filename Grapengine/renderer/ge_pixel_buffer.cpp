@@ -0,0 +1,71 @@
+#include "renderer/ge_pixel_buffer.hpp"
+
+#include "core/ge_assert.hpp"
+#include "profiling/ge_profiler.hpp"
+#include "renderer/ge_gl_state_cache.hpp"
+
+#include <glad/glad.h>
+
+#include <cstring>
+
+using namespace GE;
+
+PixelBuffer::PixelBuffer(const Image& image) :
+    m_dimension(image.dimension), m_format(image.format), m_levels(image.levels)
+{
+  GE_PROFILE;
+  const auto size = static_cast<i64>(image.pixels.size());
+  u32 id = 0;
+  glCreateBuffers(1, &id);
+  m_id = RendererID{ id };
+  glNamedBufferStorage(id, size, nullptr, GL_MAP_WRITE_BIT);
+
+  void* mapped = glMapNamedBufferRange(id, 0, size, GL_MAP_WRITE_BIT);
+  GE_ASSERT(mapped != nullptr, "Failure at mapping the pixel buffer");
+  std::memcpy(mapped, image.pixels.data(), image.pixels.size());
+  glUnmapNamedBuffer(id);
+}
+
+PixelBuffer::~PixelBuffer()
+{
+  if (m_fence != nullptr)
+    glDeleteSync(static_cast<GLsync>(m_fence));
+
+  const u32 id = u32(m_id);
+  glDeleteBuffers(1, &id);
+  GLStateCache::Get().OnBufferDeleted(id);
+}
+
+RendererID PixelBuffer::GetID() const
+{
+  return m_id;
+}
+
+Dimensions PixelBuffer::GetDimension() const
+{
+  return m_dimension;
+}
+
+PixelFormat PixelBuffer::GetFormat() const
+{
+  return m_format;
+}
+
+u32 PixelBuffer::GetLevelsCount() const
+{
+  return m_levels;
+}
+
+void PixelBuffer::Fence()
+{
+  GE_ASSERT(m_fence == nullptr, "Pixel buffer fenced twice");
+  m_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+bool PixelBuffer::IsDone() const
+{
+  if (m_fence == nullptr)
+    return false;
+  const u32 status = glClientWaitSync(static_cast<GLsync>(m_fence), 0, 0);
+  return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
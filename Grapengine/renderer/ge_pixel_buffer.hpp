@@ -0,0 +1,47 @@
+#ifndef GRAPENGINE_GE_PIXEL_BUFFER_HPP
+#define GRAPENGINE_GE_PIXEL_BUFFER_HPP
+
+#include "ge_renderer_id.hpp"
+#include "renderer/ge_image.hpp"
+
+namespace GE
+{
+  /**
+   * Pixels of an image copied to a pixel unpack buffer, so a texture upload from it is done by
+   * the GPU without blocking the caller. The buffer is fenced after the upload, and must be kept
+   * until the fence is done.
+   */
+  class PixelBuffer
+  {
+  public:
+    explicit PixelBuffer(const Image& image);
+    ~PixelBuffer();
+
+    PixelBuffer(const PixelBuffer&) = delete;
+    PixelBuffer& operator=(const PixelBuffer&) = delete;
+
+    [[nodiscard]] RendererID GetID() const;
+    [[nodiscard]] Dimensions GetDimension() const;
+    [[nodiscard]] PixelFormat GetFormat() const;
+    [[nodiscard]] u32 GetLevelsCount() const;
+
+    /**
+     * Fence the buffer after the uploads that read it were issued
+     */
+    void Fence();
+
+    /**
+     * Whether the GPU has passed the fence, which does not wait for it
+     */
+    [[nodiscard]] bool IsDone() const;
+
+  private:
+    RendererID m_id = 0;
+    Dimensions m_dimension;
+    PixelFormat m_format;
+    u32 m_levels;
+    void* m_fence = nullptr;
+  };
+}
+
+#endif // GRAPENGINE_GE_PIXEL_BUFFER_HPP
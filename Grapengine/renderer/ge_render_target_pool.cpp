@@ -0,0 +1,102 @@
+#include "renderer/ge_render_target_pool.hpp"
+
+#include "core/ge_platform.hpp"
+#include "profiling/ge_profiler.hpp"
+#include "renderer/ge_gl_state_cache.hpp"
+
+#include <glad/glad.h>
+
+using namespace GE;
+
+namespace
+{
+  /**
+   * Frames a released texture is kept for before being deleted
+   */
+  constexpr u64 RELEASED_FRAMES = 120;
+
+  u32 GetGLInternalFormat(AttachmentFormat format)
+  {
+    switch (format)
+    {
+    case AttachmentFormat::RGBA8:
+      return GL_RGBA8;
+    case AttachmentFormat::DEPTH24_STENCIL8:
+      return GL_DEPTH24_STENCIL8;
+    }
+    Platform::Unreachable();
+  }
+
+  void DeleteTexture(RendererID texture)
+  {
+    const u32 id = u32(texture);
+    glDeleteTextures(1, &id);
+    GLStateCache::Get().OnTextureDeleted(id);
+  }
+}
+
+RenderTargetPool& RenderTargetPool::Get()
+{
+  static RenderTargetPool pool;
+  return pool;
+}
+
+RendererID RenderTargetPool::Acquire(const RenderTargetSpec& spec)
+{
+  GE_PROFILE;
+  const auto it =
+    std::ranges::find(m_released, spec, [](const ReleasedTarget& rt) { return rt.spec; });
+  if (it != m_released.end())
+  {
+    const RendererID texture = it->texture;
+    m_released.erase(it);
+    return texture;
+  }
+
+  m_allocations_count++;
+  const auto [width, height] = spec.dimension;
+  const u32 internal_format = GetGLInternalFormat(spec.format);
+  u32 id = 0;
+  if (spec.samples > 1)
+  {
+    glCreateTextures(GL_TEXTURE_2D_MULTISAMPLE, 1, &id);
+    glTextureStorage2DMultisample(
+      id, i32(spec.samples), internal_format, i32(width), i32(height), GL_TRUE);
+    return RendererID{ id };
+  }
+
+  glCreateTextures(GL_TEXTURE_2D, 1, &id);
+  glTextureStorage2D(id, 1, internal_format, i32(width), i32(height));
+  glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  return RendererID{ id };
+}
+
+void RenderTargetPool::Release(const RenderTargetSpec& spec, RendererID texture)
+{
+  if (u32(texture) != 0)
+    m_released.push_back({ spec, texture, m_frame });
+}
+
+void RenderTargetPool::Trim()
+{
+  m_frame++;
+  const auto expired = [&](const ReleasedTarget& rt)
+  { return rt.frame + RELEASED_FRAMES < m_frame; };
+  for (const ReleasedTarget& released : m_released)
+    if (expired(released))
+      DeleteTexture(released.texture);
+  std::erase_if(m_released, expired);
+}
+
+void RenderTargetPool::Clear()
+{
+  for (const ReleasedTarget& released : m_released)
+    DeleteTexture(released.texture);
+  m_released.clear();
+}
+
+u64 RenderTargetPool::TakeAllocationsCount()
+{
+  return std::exchange(m_allocations_count, 0);
+}
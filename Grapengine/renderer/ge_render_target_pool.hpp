@@ -0,0 +1,80 @@
+#ifndef GRAPENGINE_GE_RENDER_TARGET_POOL_HPP
+#define GRAPENGINE_GE_RENDER_TARGET_POOL_HPP
+
+#include "ge_renderer_id.hpp"
+#include "utils/ge_dimension.hpp"
+
+namespace GE
+{
+  enum class AttachmentFormat : u8
+  {
+    RGBA8,
+    DEPTH24_STENCIL8
+  };
+
+  struct RenderTargetSpec
+  {
+    Dimensions dimension;
+    AttachmentFormat format;
+    u32 samples = 1;
+
+    [[nodiscard]] bool operator==(const RenderTargetSpec& rhs) const = default;
+  };
+
+  /**
+   * Textures used as framebuffer attachments, kept after being released so that another pass or
+   * viewport asking for the same dimension, format and samples reuses them instead of
+   * allocating. Textures not reused for a while are deleted. The textures belong to the current
+   * context, so the pool must be cleared before the context is destroyed.
+   */
+  class RenderTargetPool
+  {
+  public:
+    static RenderTargetPool& Get();
+
+    RenderTargetPool() = default;
+    ~RenderTargetPool() = default;
+
+    RenderTargetPool(const RenderTargetPool&) = delete;
+    RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+    /**
+     * Texture with the spec, reused from the released ones when possible
+     */
+    [[nodiscard]] RendererID Acquire(const RenderTargetSpec& spec);
+
+    /**
+     * Give back a texture acquired with the spec, which must not be used anymore
+     */
+    void Release(const RenderTargetSpec& spec, RendererID texture);
+
+    /**
+     * Advance a frame and delete the textures released too many frames ago
+     */
+    void Trim();
+
+    /**
+     * Delete every released texture, while their context is still current
+     */
+    void Clear();
+
+    /**
+     * Number of textures allocated since the last call, which resets it
+     */
+    u64 TakeAllocationsCount();
+
+  private:
+    struct ReleasedTarget
+    {
+      RenderTargetSpec spec;
+      RendererID texture;
+      u64 frame;
+    };
+
+    std::vector<ReleasedTarget> m_released;
+    u64 m_frame = 0;
+    u64 m_allocations_count = 0;
+  };
+}
+
+#endif // GRAPENGINE_GE_RENDER_TARGET_POOL_HPP
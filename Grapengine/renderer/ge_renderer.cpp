@@ -4,7 +4,12 @@
 #include "core/ge_platform.hpp"
 #include "drawables/ge_drawing_object.hpp"
 #include "ge_batch_renderer.hpp"
+#include "ge_instance_renderer.hpp"
 #include "profiling/ge_profiler.hpp"
+#include "renderer/ge_frame_uniforms.hpp"
+#include "renderer/ge_gl_state_cache.hpp"
+#include "renderer/ge_render_target_pool.hpp"
+#include "renderer/ge_shader.hpp"
 #include "renderer/ge_vertex_array.hpp"
 
 #include <glad/glad.h>
@@ -13,10 +18,23 @@ using namespace GE;
 
 namespace
 {
-  void OnShader(std::function<void(MaterialShader&)> fun)
+  MaterialShader& GetBatchShader(MaterialShading shading)
   {
-    static MaterialShader shader;
-    fun(shader);
+    static MaterialShader lit_shader{ MaterialInput::BATCHED_VERTICES, MaterialShading::LIT };
+    static MaterialShader unlit_shader{ MaterialInput::BATCHED_VERTICES, MaterialShading::UNLIT };
+    return shading == MaterialShading::UNLIT ? unlit_shader : lit_shader;
+  }
+
+  MaterialShading& GetBatchShading()
+  {
+    static MaterialShading shading = MaterialShading::LIT;
+    return shading;
+  }
+
+  MaterialShader& GetInstancingShader()
+  {
+    static MaterialShader shader{ MaterialInput::INSTANCES };
+    return shader;
   }
 
   //--------------------------------------------------------------------------------------------------
@@ -26,6 +44,12 @@ namespace
     return batch_renderer;
   }
 
+  InstanceRenderer& GetInstanceRenderer()
+  {
+    static InstanceRenderer instance_renderer;
+    return instance_renderer;
+  }
+
   u64& GetTiming()
   {
     static u64 timing = 0;
@@ -68,11 +92,11 @@ void Renderer::Init()
 
   glEnable(GL_MULTISAMPLE);
 
-  glEnable(GL_BLEND);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  GLStateCache::Get().SetBlend(true);
+  GLStateCache::Get().SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-  glEnable(GL_DEPTH_TEST);
-  glDepthFunc(GL_LESS);
+  GLStateCache::Get().SetDepthTest(true);
+  GLStateCache::Get().SetDepthFunc(GL_LESS);
 
   glEnable(GL_LINE_SMOOTH);
   glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
@@ -119,35 +143,31 @@ Renderer::Statistics& Renderer::GetStats()
 
 void Renderer::SetAmbientLight(const Color& color, f32 str)
 {
-  OnShader(
-    [&](MaterialShader& shader)
-    {
-      shader.Activate();
-      shader.UpdateAmbientLight(color, str);
-    });
+  FrameUniforms::Get().SetAmbientLight(color, str);
 }
 
 void Renderer::SetLightSources(const std::vector<LightSource>& props)
 {
-  OnShader(
-    [&](MaterialShader& shader)
-    {
-      shader.Activate();
-      shader.UpdateLightSources(props);
-    });
+  FrameUniforms::Get().SetLightSources(props);
 }
 
-void Renderer::SetTextureSlots(const std::vector<i32>& textureSlots)
+void Renderer::SetTextureLayers(std::span<const i32> textureLayers)
 {
-  OnShader(
-    [&](MaterialShader& shader)
-    {
-      shader.Activate();
-      shader.UpdateTextures(textureSlots);
-    });
+  FrameUniforms::Get().SetTextureLayers(textureLayers);
 }
 
-void Renderer::Batch::Begin(const Mat4& cameraMatrix, const Vec3& viewPosition)
+void Renderer::EndFrame()
+{
+  GetBatchRenderer().EndFrame();
+  GetStats().uniform_uploads = Shader::TakeUploadsCount();
+  GetStats().state_calls_avoided = GLStateCache::Get().TakeStatistics().calls_avoided;
+  GetStats().attachment_allocations = RenderTargetPool::Get().TakeAllocationsCount();
+  RenderTargetPool::Get().Trim();
+}
+
+void Renderer::Batch::Begin(const Mat4& cameraMatrix,
+                             const Vec3& viewPosition,
+                             MaterialShading shading)
 {
   GE_PROFILE;
   {
@@ -155,31 +175,70 @@ void Renderer::Batch::Begin(const Mat4& cameraMatrix, const Vec3& viewPosition)
     GetStats().indices_count = 0;
     GetTiming() = Platform::GetCurrentTimeNS();
   }
-  OnShader(
-    [&](MaterialShader& shader)
-    {
-      shader.Activate();
-      shader.UpdateViewProjectionMatrix(cameraMatrix, viewPosition);
-    });
-  GetBatchRenderer().Begin();
+  GetBatchShading() = shading;
+  GetBatchShader(shading).UpdateViewProjectionMatrix(cameraMatrix, viewPosition);
+  GetBatchRenderer().Begin(viewPosition, FrameUniforms::Get().GetTextureLayers());
 }
 
 void Renderer::Batch::End()
 {
   GE_PROFILE;
-  OnShader([&](MaterialShader& shader) { shader.Activate(); });
-  GetBatchRenderer().End();
+  FrameUniforms::Get().Upload();
+  MaterialShader& shader = GetBatchShader(GetBatchShading());
+  shader.Activate();
+  GetBatchRenderer().End(shader);
   {
     GetStats().time_spent = (Platform::GetCurrentTimeNS() - GetTiming()) + 1;
   }
 }
 
-void Renderer::Batch::PushObject(VerticesData&& vd,
+void Renderer::Batch::PushObject(const VerticesData& vd,
                                  const std::vector<u32>& indices,
                                  const Mat4& modelMat)
+{
+  const BatchDraw draw{ vd.GetData(), indices, modelMat };
+  PushObjects({ &draw, 1 });
+}
+
+void Renderer::Batch::PushObjects(std::span<const BatchDraw> draws)
+{
+  GE_PROFILE;
+  for (const BatchDraw& draw : draws)
+  {
+    GetStats().vertices_count += draw.vertices.size();
+    GetStats().indices_count += draw.indices.size();
+  }
+  GetBatchRenderer().PushObjects(draws);
+}
+
+u32 Renderer::Instancing::AcquireMesh(const Drawable& drawable)
+{
+  return GetInstanceRenderer().AcquireMesh(drawable);
+}
+
+void Renderer::Instancing::ReleaseMesh(u32 mesh)
+{
+  GetInstanceRenderer().ReleaseMesh(mesh);
+}
+
+void Renderer::Instancing::Begin(const Mat4& cameraMatrix, const Vec3& viewPosition)
+{
+  GE_PROFILE;
+  GetStats().instances_count = 0;
+  GetInstancingShader().UpdateViewProjectionMatrix(cameraMatrix, viewPosition);
+  GetInstanceRenderer().Begin(FrameUniforms::Get().GetTextureLayers());
+}
+
+void Renderer::Instancing::End()
 {
   GE_PROFILE;
-  GetStats().vertices_count += vd.GetCount();
-  GetStats().indices_count += indices.size();
-  GetBatchRenderer().PushObject(std::move(vd), indices, modelMat);
+  FrameUniforms::Get().Upload();
+  GetInstancingShader().Activate();
+  GetInstanceRenderer().End(GetInstancingShader());
+}
+
+void Renderer::Instancing::PushInstance(u32 mesh, const Mat4& modelMat, Color color, u32 texSlot)
+{
+  GetStats().instances_count++;
+  GetInstanceRenderer().PushInstance(mesh, modelMat, color, texSlot);
 }
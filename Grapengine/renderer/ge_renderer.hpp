@@ -5,12 +5,15 @@
 #include "ge_light_source.hpp"
 #include "math/ge_vector.hpp"
 #include "renderer/ge_vertices_data.hpp"
+#include "renderer/shader_programs/ge_material_shader.hpp"
 #include "utils/ge_dimension.hpp"
 
 namespace GE
 {
   class VertexArray;
   class DrawingObject;
+  class Drawable;
+  struct BatchDraw;
 
   class Renderer
   {
@@ -32,23 +35,66 @@ namespace GE
     static void SetAmbientLight(const Color& color, f32 str);
     static void SetLightSources(const std::vector<LightSource>& props);
 
-    static void SetTextureSlots(const std::vector<i32>& textureSlots);
+    static void SetTextureLayers(std::span<const i32> textureLayers);
+
+    /**
+     * Close the statistics of the frame, which is called once per frame by the application
+     */
+    static void EndFrame();
 
     class Batch
     {
     public:
-      static void Begin(const Mat4& cameraMatrix, const Vec3& viewPosition);
+      /**
+       * Start a batch drawn by the lit or the unlit material shader
+       */
+      static void Begin(const Mat4& cameraMatrix,
+                        const Vec3& viewPosition,
+                        MaterialShading shading = MaterialShading::LIT);
 
       static void End();
 
+      /**
+       * Add an object to the batch. Its vertices and indices are read in place when the batch
+       * ends, so they must live until then.
+       */
       static void
-      PushObject(VerticesData&& vd, const std::vector<u32>& indices, const Mat4& modelMat);
+      PushObject(const VerticesData& vd, const std::vector<u32>& indices, const Mat4& modelMat);
+
+      /**
+       * Add a whole draw list to the batch, which is built on the thread pool when it ends
+       */
+      static void PushObjects(std::span<const BatchDraw> draws);
+    };
+
+    /**
+     * Instanced drawing of objects that share their geometry, which is uploaded only once
+     */
+    class Instancing
+    {
+    public:
+      /**
+       * Reference the mesh with the geometry of the drawable, uploading it when new
+       * @return mesh id, to be released when it is no longer drawn
+       */
+      static u32 AcquireMesh(const Drawable& drawable);
+      static void ReleaseMesh(u32 mesh);
+
+      static void Begin(const Mat4& cameraMatrix, const Vec3& viewPosition);
+
+      static void End();
+
+      static void PushInstance(u32 mesh, const Mat4& modelMat, Color color, u32 texSlot);
     };
 
     struct Statistics
     {
       u64 vertices_count = 0;
       u64 indices_count = 0;
+      u64 instances_count = 0;
+      u64 uniform_uploads = 0;
+      u64 state_calls_avoided = 0;
+      u64 attachment_allocations = 0;
       u64 time_spent = 1;
     };
 
@@ -1,6 +1,7 @@
 #include "renderer/ge_shader.hpp"
 
 #include "core/ge_assert.hpp"
+#include "renderer/ge_gl_state_cache.hpp"
 #include "profiling/ge_profiler.hpp"
 #include "utils/ge_io.hpp"
 
@@ -11,6 +12,8 @@ using namespace GE;
 
 namespace
 {
+  u64 s_uploads_count = 0;
+
   enum class ShaderType : u8
   {
     VERTEX,
@@ -120,6 +123,7 @@ Shader::Shader(const std::string& vertexSrc, const std::string& fragmentSrc) :
     m_renderer_id(CreateProgram(vertexSrc, fragmentSrc))
 {
   GE_PROFILE;
+  ResolveUniforms();
 }
 
 Shader::Shader(const std::filesystem::path& vertexPath, const std::filesystem::path& fragPath) :
@@ -129,57 +133,65 @@ Shader::Shader(const std::filesystem::path& vertexPath, const std::filesystem::p
   auto vertex_src = IO::ReadFileToString(vertexPath);
   auto frag_src = IO::ReadFileToString(fragPath);
   m_renderer_id = CreateProgram(vertex_src, frag_src);
+  ResolveUniforms();
 }
 
 void Shader::Bind() const
 {
-  glUseProgram(u32(m_renderer_id));
+  GLStateCache::Get().UseProgram(u32(m_renderer_id));
 }
 
-Shader::~Shader() = default;
+Shader::~Shader()
+{
+  if (u32(m_renderer_id) == 0)
+    return;
 
-void Shader::UploadMat4F(const std::string& name, const Mat4& mat)
+  glDeleteProgram(u32(m_renderer_id));
+  GLStateCache::Get().OnProgramDeleted(u32(m_renderer_id));
+}
+
+void Shader::UploadMat4F(UniformName name, const Mat4& mat)
 {
   UploadMat4F(name, mat.ValuePtr());
 }
 
-void Shader::UploadMat4F(const std::string& name, const f32* data)
+void Shader::UploadMat4F(UniformName name, const f32* data)
 {
   auto location = RetrieveUniform(name);
   glUniformMatrix4fv(location, 1, GL_FALSE, data);
 }
 
-void Shader::UploadInt(const std::string& name, i32 i)
+void Shader::UploadInt(UniformName name, i32 i)
 {
   auto location = RetrieveUniform(name);
   glUniform1i(location, i);
 }
 
-void Shader::UploadFloat(const std::string& name, f32 i)
+void Shader::UploadFloat(UniformName name, f32 i)
 {
   auto location = RetrieveUniform(name);
   glUniform1f(location, i);
 }
 
-void Shader::UploadVec3(const std::string& name, const Vec3& vec3)
+void Shader::UploadVec3(UniformName name, const Vec3& vec3)
 {
   auto location = RetrieveUniform(name);
   glUniform3f(location, vec3.x, vec3.y, vec3.z);
 }
 
-void GE::Shader::UploadVec3Array(const std::string& name, const std::vector<Vec3>& vec3)
+void GE::Shader::UploadVec3Array(UniformName name, const std::vector<Vec3>& vec3)
 {
   auto location = RetrieveUniform(name);
   glUniform3fv(location, static_cast<GLsizei>(vec3.size()), &vec3.data()->x);
 }
 
-void GE::Shader::UploadFloatArray(const std::string& name, const std::vector<f32>& vec3)
+void GE::Shader::UploadFloatArray(UniformName name, const std::vector<f32>& vec3)
 {
   auto location = RetrieveUniform(name);
   glUniform1fv(location, static_cast<GLsizei>(vec3.size()), vec3.data());
 }
 
-void Shader::UploadIntArray(const std::string& name, const std::vector<i32>& arr)
+void Shader::UploadIntArray(UniformName name, const std::vector<i32>& arr)
 {
   auto location = RetrieveUniform(name);
   glUniform1iv(location, static_cast<i32>(arr.size()), static_cast<const i32*>(arr.data()));
@@ -192,6 +204,7 @@ void Shader::UploadIntArray(const std::string& name, const std::vector<i32>& arr
 
 bool Shader::IsBound() const
 {
+  // Asked to GL, so the assertions on uploads also catch programs changed behind the cache
   i32 curr_program = -1;
   glGetIntegerv(GL_CURRENT_PROGRAM, &curr_program);
   if (curr_program <= 0)
@@ -203,7 +216,7 @@ bool Shader::IsBound() const
 void Shader::Unbind() const
 {
   if (IsBound())
-    glUseProgram(0);
+    GLStateCache::Get().UseProgram(0);
 }
 Ptr<Shader> GE::Shader::Make(const std::filesystem::path& vertexPath,
                              const std::filesystem::path& fragPath)
@@ -211,16 +224,60 @@ Ptr<Shader> GE::Shader::Make(const std::filesystem::path& vertexPath,
   return MakeScope<Shader>(vertexPath, fragPath);
 }
 
-i32 Shader::RetrieveUniform(const std::string& name)
+u64 Shader::TakeUploadsCount()
 {
-  GE_ASSERT(IsBound(), "Shader not bound");
+  return std::exchange(s_uploads_count, 0);
+}
+
+void Shader::ResolveUniforms()
+{
+  GE_PROFILE;
+  const u32 program = u32(m_renderer_id);
+  if (program == 0)
+    return;
 
-  if (m_uniforms.contains(name))
-    return m_uniforms[name];
+  i32 count = 0;
+  i32 max_length = 0;
+  glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+  glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
 
-  const i32 location = glGetUniformLocation(u32(m_renderer_id), name.c_str());
-  GE_ASSERT(location != -1, "Invalid uniform name: {}", name);
+  std::vector<char> name_buffer(static_cast<u64>(max_length) + 1);
+  for (u32 index = 0; index < u32(count); index++)
+  {
+    i32 length = 0;
+    i32 size = 0;
+    u32 type = 0;
+    glGetActiveUniform(program, index, max_length, &length, &size, &type, name_buffer.data());
+
+    std::string_view name{ name_buffer.data(), static_cast<u64>(length) };
+    // Members of uniform blocks have no location
+    const i32 location = glGetUniformLocation(program, name_buffer.data());
+    if (location == -1)
+      continue;
+
+    if (name.ends_with("[0]"))
+      name.remove_suffix(3);
+    m_uniforms.emplace_back(UniformName::Hash(name), location);
+  }
 
-  m_uniforms[name] = location;
-  return location;
+  std::ranges::sort(m_uniforms);
+  GE_ASSERT(std::ranges::adjacent_find(m_uniforms,
+                                       [](auto&& a, auto&& b) { return a.first == b.first; }) ==
+              m_uniforms.end(),
+            "Uniform names with the same hash");
+}
+
+i32 Shader::RetrieveUniform(UniformName name) const
+{
+  GE_ASSERT(IsBound(), "Shader not bound");
+  s_uploads_count++;
+
+  const auto it = std::ranges::lower_bound(
+    m_uniforms, name.GetHash(), std::ranges::less{}, [](auto&& u) { return u.first; });
+  if (it == m_uniforms.end() || it->first != name.GetHash())
+  {
+    GE_ASSERT(false, "Invalid uniform name: {}", name.GetName());
+    return -1;
+  }
+  return it->second;
 }
@@ -7,6 +7,39 @@
 #include <filesystem>
 namespace GE
 {
+  /**
+   * Name of a uniform, hashed at compile time so that uploads neither allocate nor hash
+   */
+  class UniformName
+  {
+  public:
+    consteval UniformName(const char* name) : // NOLINT(*-explicit-constructor)
+        m_name(name), m_hash(Hash(m_name))
+    {
+    }
+
+    [[nodiscard]] constexpr std::string_view GetName() const { return m_name; }
+    [[nodiscard]] constexpr u64 GetHash() const { return m_hash; }
+
+    /**
+     * 64-bit FNV-1a, also used to index the uniforms found when the program is linked
+     */
+    static constexpr u64 Hash(std::string_view name)
+    {
+      u64 hash = 14695981039346656037ULL;
+      for (const char c : name)
+      {
+        hash ^= static_cast<u8>(c);
+        hash *= 1099511628211ULL;
+      }
+      return hash;
+    }
+
+  private:
+    std::string_view m_name;
+    u64 m_hash;
+  };
+
   class Shader
   {
   public:
@@ -15,6 +48,8 @@ namespace GE
 
     Shader(const std::filesystem::path& vertexPath, const std::filesystem::path& fragPath);
     Shader(const std::string& vertexSrc, const std::string& fragmentSrc);
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
     ~Shader();
 
     [[nodiscard]] bool IsValid() const;
@@ -23,25 +58,36 @@ namespace GE
     void Bind() const;
     void Unbind() const;
 
-    void UploadMat4F(const std::string& name, const Mat4& mat);
+    void UploadMat4F(UniformName name, const Mat4& mat);
 
-    void UploadMat4F(const std::string& name, const f32* data);
+    void UploadMat4F(UniformName name, const f32* data);
 
-    void UploadInt(const std::string& name, i32 i);
+    void UploadInt(UniformName name, i32 i);
 
-    void UploadFloat(const std::string& name, f32 i);
+    void UploadFloat(UniformName name, f32 i);
 
-    void UploadVec3(const std::string& name, const Vec3& vec3);
+    void UploadVec3(UniformName name, const Vec3& vec3);
 
-    void UploadVec3Array(const std::string& name, const std::vector<Vec3>& vec3);
-    void UploadFloatArray(const std::string& name, const std::vector<f32>& vec3);
-    void UploadIntArray(const std::string& name, const std::vector<i32>& arr);
+    void UploadVec3Array(UniformName name, const std::vector<Vec3>& vec3);
+    void UploadFloatArray(UniformName name, const std::vector<f32>& vec3);
+    void UploadIntArray(UniformName name, const std::vector<i32>& arr);
+
+    /**
+     * Number of uniform uploads of all shaders since the last call, which resets it
+     */
+    static u64 TakeUploadsCount();
 
   private:
-    i32 RetrieveUniform(const std::string& name);
+    /**
+     * Fill the location table with the active uniforms of the linked program, keyed by the hash
+     * of their names. Arrays are keyed by the name without the "[0]" suffix.
+     */
+    void ResolveUniforms();
+
+    i32 RetrieveUniform(UniformName name) const;
 
     RendererID m_renderer_id;
-    std::unordered_map<std::string, i32> m_uniforms;
+    std::vector<std::pair<u64, i32>> m_uniforms;
   };
 }
 #endif
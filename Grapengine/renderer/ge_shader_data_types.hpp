@@ -26,7 +26,13 @@ namespace GE
     COLOR_F4,
     TEXTURE_COORDINATE_F2,
     NORMAL_F3,
-    TEX_ID_INT
+    TEX_ID_INT,
+    MODEL_MATRIX_F16,
+    NORMAL_MATRIX_F9,
+    COLOR_RGBA8,
+    TEXTURE_COORDINATE_H2,
+    NORMAL_SNORM_1010102,
+    TEX_ID_U16
   };
 }
 
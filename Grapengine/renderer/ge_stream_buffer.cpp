@@ -0,0 +1,127 @@
+#include "renderer/ge_stream_buffer.hpp"
+
+#include "core/ge_assert.hpp"
+#include "profiling/ge_profiler.hpp"
+#include "renderer/ge_gl_state_cache.hpp"
+
+#include <glad/glad.h>
+
+using namespace GE;
+
+namespace
+{
+  constexpr u32 STORAGE_FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  constexpr u64 FENCE_TIMEOUT_NS = 1'000'000;
+
+  /**
+   * Block until the GPU passes the fence, then delete it
+   */
+  void WaitAndDelete(GLsync fence)
+  {
+    GE_PROFILE;
+    // Commands are flushed only on the first try, which is enough for the fence to be reached
+    u32 flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    u32 status = GL_TIMEOUT_EXPIRED;
+    while (status == GL_TIMEOUT_EXPIRED)
+    {
+      status = glClientWaitSync(fence, flags, FENCE_TIMEOUT_NS);
+      flags = 0;
+    }
+    GE_ASSERT(status != GL_WAIT_FAILED, "Failure at waiting for a stream buffer fence");
+    glDeleteSync(fence);
+  }
+}
+
+Ptr<StreamBuffer> StreamBuffer::Make(u64 elementSize, u64 regionElements)
+{
+  return MakeRef<StreamBuffer>(elementSize, regionElements);
+}
+
+StreamBuffer::StreamBuffer(u64 elementSize, u64 regionElements) : m_element_size(elementSize)
+{
+  Allocate(regionElements);
+}
+
+StreamBuffer::~StreamBuffer()
+{
+  Release();
+}
+
+void* StreamBuffer::Append(u64 elementsCount)
+{
+  GE_PROFILE;
+  if (m_region_used + elementsCount > m_region_elements)
+  {
+    // The whole frame fits in a region of the new buffer, whose fences are all dropped
+    const u64 frame_elements = m_region_used + elementsCount;
+    Release();
+    Allocate(std::bit_ceil(frame_elements));
+    m_region_used = 0;
+  }
+
+  if (void* fence = std::exchange(m_fences.at(m_region), nullptr); fence != nullptr)
+    WaitAndDelete(static_cast<GLsync>(fence));
+
+  m_first_element = m_region * m_region_elements + m_region_used;
+  m_region_used += elementsCount;
+  return m_mapped + m_first_element * m_element_size;
+}
+
+void StreamBuffer::EndFrame()
+{
+  // Regions left empty by the frame are not read, so they need no fence
+  if (m_region_used == 0)
+    return;
+
+  GE_ASSERT(m_fences.at(m_region) == nullptr, "Stream buffer region fenced twice");
+  m_fences.at(m_region) = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  m_region = (m_region + 1) % REGIONS_COUNT;
+  m_region_used = 0;
+}
+
+RendererID StreamBuffer::GetID() const
+{
+  return m_id;
+}
+
+u64 StreamBuffer::GetAllocationsCount() const
+{
+  return m_allocations_count;
+}
+
+u64 StreamBuffer::GetFirstElement() const
+{
+  return m_first_element;
+}
+
+void StreamBuffer::Allocate(u64 regionElements)
+{
+  GE_PROFILE;
+  m_allocations_count++;
+  m_region_elements = regionElements;
+  const auto size = static_cast<i64>(m_element_size * m_region_elements * REGIONS_COUNT);
+
+  u32 id = 0;
+  glCreateBuffers(1, &id);
+  m_id = RendererID{ id };
+  glNamedBufferStorage(id, size, nullptr, STORAGE_FLAGS);
+  m_mapped = static_cast<std::byte*>(glMapNamedBufferRange(id, 0, size, STORAGE_FLAGS));
+  GE_ASSERT(m_mapped != nullptr, "Failure at mapping the stream buffer");
+}
+
+void StreamBuffer::Release()
+{
+  // Pending draws keep the storage alive, so the fences are only dropped
+  for (void*& fence : m_fences)
+  {
+    if (fence != nullptr)
+      glDeleteSync(static_cast<GLsync>(fence));
+    fence = nullptr;
+  }
+
+  const u32 id = u32(m_id);
+  glUnmapNamedBuffer(id);
+  glDeleteBuffers(1, &id);
+  GLStateCache::Get().OnBufferDeleted(id);
+  m_mapped = nullptr;
+}
@@ -0,0 +1,74 @@
+#ifndef GRAPENGINE_GE_STREAM_BUFFER_HPP
+#define GRAPENGINE_GE_STREAM_BUFFER_HPP
+
+#include "ge_renderer_id.hpp"
+
+namespace GE
+{
+  /**
+   * Buffer of dynamic data written by the CPU through a persistent and coherent mapping. It is
+   * split in a region per frame in flight, used in turn. Each pass of a frame appends its data
+   * to the region of the frame, which is fenced once the frame ends, so a region is only
+   * written again once the GPU is done with the whole frame. Writing neither stalls on a buffer
+   * in use nor reallocates while the data of a frame fits in a region.
+   */
+  class StreamBuffer
+  {
+  public:
+    /**
+     * Frames in flight, whatever the number of passes of each frame
+     */
+    static constexpr u32 REGIONS_COUNT = 3;
+
+    static Ptr<StreamBuffer> Make(u64 elementSize, u64 regionElements);
+
+    StreamBuffer(u64 elementSize, u64 regionElements);
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    /**
+     * Append the elements to the region of the frame and return their mapped memory. The first
+     * append of a frame waits for the GPU to finish reading the region. When the elements do not
+     * fit, every region grows and the buffer is recreated, possibly with the same id as the
+     * deleted one, while the draws already issued keep reading the old one.
+     */
+    [[nodiscard]] void* Append(u64 elementsCount);
+
+    /**
+     * Fence the region of the frame after the draws of all of its passes were issued, and move
+     * to the next one
+     */
+    void EndFrame();
+
+    [[nodiscard]] RendererID GetID() const;
+
+    /**
+     * Number of times the buffer was allocated, which tells whether it was recreated since it
+     * was attached to a vertex array even when GL gave it back the same id
+     */
+    [[nodiscard]] u64 GetAllocationsCount() const;
+
+    /**
+     * Index of the first element of the last append, counted from the start of the buffer
+     */
+    [[nodiscard]] u64 GetFirstElement() const;
+
+  private:
+    void Allocate(u64 regionElements);
+    void Release();
+
+    RendererID m_id = 0;
+    u64 m_element_size = 0;
+    u64 m_region_elements = 0;
+    u32 m_region = 0;
+    u64 m_region_used = 0;
+    u64 m_first_element = 0;
+    u64 m_allocations_count = 0;
+    std::byte* m_mapped = nullptr;
+    std::array<void*, REGIONS_COUNT> m_fences{};
+  };
+}
+
+#endif // GRAPENGINE_GE_STREAM_BUFFER_HPP
@@ -1,14 +1,9 @@
 #include "renderer/ge_texture_2d.hpp"
 
-#include <glad/glad.h>
+#include "renderer/ge_gl_state_cache.hpp"
+#include "renderer/ge_image.hpp"
 
-// clang-format off
-#define STB_IMAGE_IMPLEMENTATION
-#if defined(GE_GCC_COMPILER) && (__GNUC__ <= 12)
-#define STBI_NO_SIMD
-#endif
-#include <stb_image.h>
-// clang-format on
+#include <glad/glad.h>
 
 #include "core/ge_assert.hpp"
 #include "profiling/ge_profiler.hpp"
@@ -24,45 +19,28 @@ Texture2D::Texture2D(const std::filesystem::path& path) : m_dim(), m_renderer_ID
 {
   GE_PROFILE;
 
-  GE_ASSERT(std::filesystem::exists(path), "File not found at: {}", path.string());
-
-  stbi_set_flip_vertically_on_load(1);
-  i32 w{};
-  i32 h{};
-  i32 channels{};
-  stbi_uc* data = stbi_load(path.string().c_str(), &w, &h, &channels, 0);
-
-  m_dim = Dimensions{ u32(w), u32(h) };
-
-  u32 internal_format = 0;
-  u32 format = 0;
-  if (channels == 4)
-  {
-    internal_format = GL_RGBA8;
-    format = GL_RGBA;
-  }
-  else if (channels != 0)
-  {
-    internal_format = GL_RGB8;
-    format = GL_RGB;
-  }
+  const Image image = Image::Load(path);
+  GE_ASSERT(!image.IsCompressed(), "Compressed textures are only loaded into texture arrays");
+  m_dim = image.dimension;
+  const auto w = i32(m_dim.width);
+  const auto h = i32(m_dim.height);
 
   {
     u32 id = 0;
     glCreateTextures(GL_TEXTURE_2D, 1, &id);
     m_renderer_ID = RendererID{ id };
   }
-  glTextureStorage2D(u32(m_renderer_ID), 1, internal_format, w, h);
+  glTextureStorage2D(u32(m_renderer_ID), i32(Image::MipLevelsCount(m_dim)), GL_RGBA8, w, h);
 
-  glTextureParameteri(u32(m_renderer_ID), GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTextureParameteri(u32(m_renderer_ID), GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
   glTextureParameteri(u32(m_renderer_ID), GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
   glTextureParameteri(u32(m_renderer_ID), GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
   glTextureParameteri(u32(m_renderer_ID), GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
 
-  glTextureSubImage2D(u32(m_renderer_ID), 0, 0, 0, w, h, format, GL_UNSIGNED_BYTE, data);
-
-  stbi_image_free(data);
+  glTextureSubImage2D(
+    u32(m_renderer_ID), 0, 0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
+  glGenerateTextureMipmap(u32(m_renderer_ID));
 }
 
 Texture2D::Texture2D() : m_dim(), m_renderer_ID(0)
@@ -106,11 +84,12 @@ Texture2D::~Texture2D()
 {
   const u32 id = u32(m_renderer_ID);
   glDeleteTextures(1, &id);
+  GLStateCache::Get().OnTextureDeleted(id);
 }
 
 void Texture2D::Bind(u32 slot) const
 {
-  glBindTextureUnit(slot, u32(m_renderer_ID));
+  GLStateCache::Get().BindTextureUnit(slot, u32(m_renderer_ID));
 }
 
 Ptr<Texture2D> GE::Texture2D::Make()
@@ -0,0 +1,212 @@
+#include "renderer/ge_texture_array.hpp"
+
+#include "core/ge_assert.hpp"
+#include "core/ge_platform.hpp"
+#include "profiling/ge_profiler.hpp"
+#include "renderer/ge_gl_state_cache.hpp"
+
+#include <glad/glad.h>
+
+using namespace GE;
+
+namespace
+{
+  // From EXT_texture_compression_s3tc, supported by every desktop driver but not core
+  constexpr u32 COMPRESSED_RGBA_S3TC_DXT1 = 0x83F1;
+  constexpr u32 COMPRESSED_RGBA_S3TC_DXT5 = 0x83F3;
+
+  u32 GetGLInternalFormat(PixelFormat format)
+  {
+    switch (format)
+    {
+    case PixelFormat::RGBA8:
+      return GL_RGBA8;
+    case PixelFormat::BC1:
+      return COMPRESSED_RGBA_S3TC_DXT1;
+    case PixelFormat::BC3:
+      return COMPRESSED_RGBA_S3TC_DXT5;
+    case PixelFormat::BC7:
+      return GL_COMPRESSED_RGBA_BPTC_UNORM;
+    }
+    Platform::Unreachable();
+  }
+}
+
+Ptr<TextureArray> TextureArray::Make(Dimensions dimension,
+                                     u32 layers,
+                                     PixelFormat format,
+                                     u32 levels)
+{
+  return MakeRef<TextureArray>(dimension, layers, format, levels);
+}
+
+TextureArray::TextureArray(Dimensions dimension, u32 layers, PixelFormat format, u32 levels) :
+    m_id(0), m_dimension(dimension), m_layers(layers), m_format(format), m_levels(levels)
+{
+  GE_PROFILE;
+  u32 id = 0;
+  glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &id);
+  m_id = RendererID{ id };
+  glTextureStorage3D(id,
+                     i32(levels),
+                     GetGLInternalFormat(format),
+                     i32(dimension.width),
+                     i32(dimension.height),
+                     i32(layers));
+
+  const i32 min_filter = levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR;
+  glTextureParameteri(id, GL_TEXTURE_MIN_FILTER, min_filter);
+  glTextureParameteri(id, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTextureParameteri(id, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTextureParameteri(id, GL_TEXTURE_WRAP_T, GL_REPEAT);
+}
+
+TextureArray::~TextureArray()
+{
+  const u32 id = u32(m_id);
+  glDeleteTextures(1, &id);
+  GLStateCache::Get().OnTextureDeleted(id);
+}
+
+void TextureArray::SetLayer(u32 layer, const Image& image)
+{
+  GE_PROFILE;
+  GE_ASSERT(image.format == m_format, "Image format differs from the texture array");
+  UploadLayer(layer, image.dimension, image.levels, image.pixels.data());
+}
+
+void TextureArray::SetLayer(u32 layer, const PixelBuffer& pixels)
+{
+  GE_PROFILE;
+  GE_ASSERT(pixels.GetFormat() == m_format, "Pixels format differs from the texture array");
+
+  GLStateCache& cache = GLStateCache::Get();
+  cache.BindBuffer(GL_PIXEL_UNPACK_BUFFER, u32(pixels.GetID()));
+  UploadLayer(layer, pixels.GetDimension(), pixels.GetLevelsCount(), nullptr);
+  cache.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void TextureArray::GenerateMipmaps(u32 layer)
+{
+  GE_PROFILE;
+  GE_ASSERT(m_format == PixelFormat::RGBA8, "Mipmaps of compressed textures are not generated");
+  GE_ASSERT_OR_RETURN_VOID(layer < m_layers, "Layer {} out of the texture array", layer);
+  if (m_levels <= 1)
+    return;
+
+  // Views need a name without storage, so it comes from glGenTextures instead of glCreateTextures
+  u32 view = 0;
+  glGenTextures(1, &view);
+  glTextureView(
+    view, GL_TEXTURE_2D_ARRAY, u32(m_id), GetGLInternalFormat(m_format), 0, m_levels, layer, 1);
+  glGenerateTextureMipmap(view);
+  glDeleteTextures(1, &view);
+}
+
+void TextureArray::CopyLayers(const TextureArray& source)
+{
+  GE_PROFILE;
+  GE_ASSERT(source.m_dimension == m_dimension && source.m_format == m_format &&
+              source.m_levels == m_levels,
+            "Texture arrays of different dimensions or formats");
+  GE_ASSERT(source.m_layers <= m_layers, "Texture array too small for the copy");
+
+  for (u32 level = 0; level < m_levels; level++)
+  {
+    const auto [width, height] = Image::LevelDimension(m_dimension, level);
+    glCopyImageSubData(u32(source.m_id),
+                       GL_TEXTURE_2D_ARRAY,
+                       i32(level),
+                       0,
+                       0,
+                       0,
+                       u32(m_id),
+                       GL_TEXTURE_2D_ARRAY,
+                       i32(level),
+                       0,
+                       0,
+                       0,
+                       i32(width),
+                       i32(height),
+                       i32(source.m_layers));
+  }
+}
+
+void TextureArray::Bind(u32 unit) const
+{
+  GLStateCache::Get().BindTextureUnit(unit, u32(m_id));
+}
+
+Dimensions TextureArray::GetDimension() const
+{
+  return m_dimension;
+}
+
+u32 TextureArray::GetLayersCount() const
+{
+  return m_layers;
+}
+
+PixelFormat TextureArray::GetFormat() const
+{
+  return m_format;
+}
+
+u32 TextureArray::GetLevelsCount() const
+{
+  return m_levels;
+}
+
+u64 TextureArray::GetLayerSize() const
+{
+  u64 size = 0;
+  for (u32 level = 0; level < m_levels; level++)
+    size += Image::LevelSize(m_format, m_dimension, level);
+  return size;
+}
+
+void TextureArray::UploadLayer(u32 layer, Dimensions dimension, u32 levels, const u8* pixels)
+{
+  GE_ASSERT(layer < m_layers, "Layer {} out of the texture array", layer);
+  GE_ASSERT(dimension == m_dimension, "Image dimension differs from the texture array");
+  GE_ASSERT(levels <= m_levels, "Image with more levels than the texture array");
+
+  u64 offset = 0;
+  for (u32 level = 0; level < levels; level++)
+  {
+    const auto [width, height] = Image::LevelDimension(m_dimension, level);
+    const u64 size = Image::LevelSize(m_format, m_dimension, level);
+    // With a pixel unpack buffer bound, the pointer is an offset into it
+    const void* data = pixels != nullptr ? static_cast<const void*>(pixels + offset)
+                                         : reinterpret_cast<const void*>(offset); // NOLINT
+    if (m_format == PixelFormat::RGBA8)
+    {
+      glTextureSubImage3D(u32(m_id),
+                          i32(level),
+                          0,
+                          0,
+                          i32(layer),
+                          i32(width),
+                          i32(height),
+                          1,
+                          GL_RGBA,
+                          GL_UNSIGNED_BYTE,
+                          data);
+    }
+    else
+    {
+      glCompressedTextureSubImage3D(u32(m_id),
+                                    i32(level),
+                                    0,
+                                    0,
+                                    i32(layer),
+                                    i32(width),
+                                    i32(height),
+                                    1,
+                                    GetGLInternalFormat(m_format),
+                                    i32(size),
+                                    data);
+    }
+    offset += size;
+  }
+}
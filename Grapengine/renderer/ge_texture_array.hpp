@@ -0,0 +1,78 @@
+#ifndef GRAPENGINE_GE_TEXTURE_ARRAY_HPP
+#define GRAPENGINE_GE_TEXTURE_ARRAY_HPP
+
+#include "ge_renderer_id.hpp"
+#include "renderer/ge_image.hpp"
+#include "renderer/ge_pixel_buffer.hpp"
+#include "utils/ge_dimension.hpp"
+
+namespace GE
+{
+  /**
+   * Textures of the same dimension and format stored as the layers of a GL_TEXTURE_2D_ARRAY, so
+   * all of them are sampled through a single binding. Mip levels are sampled with trilinear
+   * filtering.
+   */
+  class TextureArray
+  {
+  public:
+    static Ptr<TextureArray> Make(Dimensions dimension,
+                                  u32 layers,
+                                  PixelFormat format = PixelFormat::RGBA8,
+                                  u32 levels = 1);
+
+    TextureArray(Dimensions dimension, u32 layers, PixelFormat format, u32 levels);
+    ~TextureArray();
+
+    TextureArray(const TextureArray&) = delete;
+    TextureArray& operator=(const TextureArray&) = delete;
+
+    /**
+     * Upload the levels of the image to the layer, the missing ones left to GenerateMipmaps
+     */
+    void SetLayer(u32 layer, const Image& image);
+
+    /**
+     * Upload the layer from a pixel buffer, which returns before the GPU has read the pixels
+     */
+    void SetLayer(u32 layer, const PixelBuffer& pixels);
+
+    /**
+     * Compute every level but the first one of a layer, for uncompressed formats only. The
+     * other layers are left as they are, through a view of the layer.
+     */
+    void GenerateMipmaps(u32 layer);
+
+    /**
+     * Copy every layer of another array of the same dimension to the first layers of this one
+     */
+    void CopyLayers(const TextureArray& source);
+
+    void Bind(u32 unit) const;
+
+    [[nodiscard]] Dimensions GetDimension() const;
+    [[nodiscard]] u32 GetLayersCount() const;
+    [[nodiscard]] PixelFormat GetFormat() const;
+    [[nodiscard]] u32 GetLevelsCount() const;
+
+    /**
+     * Bytes of all levels of a layer
+     */
+    [[nodiscard]] u64 GetLayerSize() const;
+
+  private:
+    /**
+     * Upload the levels of a layer read from the pixels, or from offsets into the bound pixel
+     * unpack buffer when they are null
+     */
+    void UploadLayer(u32 layer, Dimensions dimension, u32 levels, const u8* pixels);
+
+    RendererID m_id;
+    Dimensions m_dimension;
+    u32 m_layers;
+    PixelFormat m_format;
+    u32 m_levels;
+  };
+}
+
+#endif // GRAPENGINE_GE_TEXTURE_ARRAY_HPP
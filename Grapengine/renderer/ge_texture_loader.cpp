@@ -0,0 +1,46 @@
+#include "renderer/ge_texture_loader.hpp"
+
+#include "core/ge_thread_pool.hpp"
+#include "renderer/ge_image_cache.hpp"
+#include "profiling/ge_profiler.hpp"
+
+using namespace GE;
+
+TextureLoader::TextureLoader() : m_state(MakeRef<State>()) {}
+
+void TextureLoader::Request(u32 slot, const std::filesystem::path& path)
+{
+  if (!m_pending.insert(slot).second)
+    return;
+
+  ThreadPool::Get().Submit(
+    [state = m_state, slot, path]
+    {
+      GE_PROFILE_SECTION("Texture decoding");
+      Image image = ImageCache::Get().Load(path);
+      const std::scoped_lock lock{ state->mutex };
+      state->decoded.push_back({ slot, std::move(image) });
+    });
+}
+
+std::vector<TextureLoader::Decoded> TextureLoader::TakeDecoded(u64 maxCount)
+{
+  std::vector<Decoded> taken;
+  {
+    const std::scoped_lock lock{ m_state->mutex };
+    const u64 count = std::min<u64>(maxCount, m_state->decoded.size());
+    std::move(m_state->decoded.begin(),
+              m_state->decoded.begin() + i64(count),
+              std::back_inserter(taken));
+    m_state->decoded.erase(m_state->decoded.begin(), m_state->decoded.begin() + i64(count));
+  }
+
+  for (const Decoded& decoded : taken)
+    m_pending.erase(decoded.slot);
+  return taken;
+}
+
+bool TextureLoader::IsPending(u32 slot) const
+{
+  return m_pending.contains(slot);
+}
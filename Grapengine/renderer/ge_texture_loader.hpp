@@ -0,0 +1,51 @@
+#ifndef GRAPENGINE_GE_TEXTURE_LOADER_HPP
+#define GRAPENGINE_GE_TEXTURE_LOADER_HPP
+
+#include "renderer/ge_image.hpp"
+
+namespace GE
+{
+  /**
+   * Decode image files on the workers of the thread pool. The decoded images are taken by the
+   * main thread, which uploads them, so loading many textures does not stall the frames.
+   */
+  class TextureLoader
+  {
+  public:
+    struct Decoded
+    {
+      u32 slot;
+      Image image;
+    };
+
+    TextureLoader();
+
+    /**
+     * Decode the file in the background, identified by the slot when taken
+     */
+    void Request(u32 slot, const std::filesystem::path& path);
+
+    /**
+     * Remove up to maxCount decoded images, in the order they were decoded
+     */
+    [[nodiscard]] std::vector<Decoded> TakeDecoded(u64 maxCount);
+
+    /**
+     * Whether the slot was requested and its image not taken yet
+     */
+    [[nodiscard]] bool IsPending(u32 slot) const;
+
+  private:
+    // Shared with the decoding tasks, which may outlive the loader
+    struct State
+    {
+      std::mutex mutex;
+      std::deque<Decoded> decoded;
+    };
+
+    Ptr<State> m_state;
+    std::set<u32> m_pending;
+  };
+}
+
+#endif // GRAPENGINE_GE_TEXTURE_LOADER_HPP
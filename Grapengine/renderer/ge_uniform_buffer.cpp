@@ -0,0 +1,36 @@
+#include "renderer/ge_uniform_buffer.hpp"
+
+#include "core/ge_assert.hpp"
+#include "renderer/ge_gl_state_cache.hpp"
+
+#include <glad/glad.h>
+
+using namespace GE;
+
+UniformBuffer::UniformBuffer(u64 size, u32 binding) : m_size(size)
+{
+  u32 id = 0;
+  glCreateBuffers(1, &id);
+  m_id = RendererID{ id };
+  glNamedBufferData(id, i64(size), nullptr, GL_DYNAMIC_DRAW);
+  glBindBufferBase(GL_UNIFORM_BUFFER, binding, id);
+}
+
+UniformBuffer::~UniformBuffer()
+{
+  const u32 id = u32(m_id);
+  glDeleteBuffers(1, &id);
+  GLStateCache::Get().OnBufferDeleted(id);
+}
+
+void UniformBuffer::SetData(const void* data, u64 size, u64 offset) const
+{
+  GE_ASSERT(offset + size <= m_size, "Uniform buffer overflow");
+
+  glNamedBufferSubData(u32(m_id), i64(offset), i64(size), data);
+}
+
+Ptr<UniformBuffer> UniformBuffer::Make(u64 size, u32 binding)
+{
+  return MakeRef<UniformBuffer>(size, binding);
+}
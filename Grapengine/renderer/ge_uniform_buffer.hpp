@@ -0,0 +1,31 @@
+#ifndef GRAPENGINE_GE_UNIFORM_BUFFER_HPP
+#define GRAPENGINE_GE_UNIFORM_BUFFER_HPP
+
+#include "ge_renderer_id.hpp"
+
+namespace GE
+{
+  /**
+   * Buffer of uniforms bound to a fixed binding point, shared by every shader that declares its
+   * uniform block with the same binding
+   */
+  class UniformBuffer
+  {
+  public:
+    static Ptr<UniformBuffer> Make(u64 size, u32 binding);
+
+    UniformBuffer(u64 size, u32 binding);
+    ~UniformBuffer();
+
+    UniformBuffer(const UniformBuffer&) = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+    void SetData(const void* data, u64 size, u64 offset = 0) const;
+
+  private:
+    RendererID m_id = 0;
+    u64 m_size = 0;
+  };
+}
+
+#endif // GRAPENGINE_GE_UNIFORM_BUFFER_HPP
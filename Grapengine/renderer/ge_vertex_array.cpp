@@ -4,6 +4,7 @@
 #include "core/ge_platform.hpp"
 #include "renderer/ge_buffer_layout.hpp"
 #include "renderer/ge_gl_checkers.hpp"
+#include "renderer/ge_gl_state_cache.hpp"
 #include "renderer/ge_index_buffer.hpp"
 #include "renderer/ge_vertex_buffer.hpp"
 
@@ -19,12 +20,18 @@ namespace
     {
     case DataPurpose::POSITION_F3:
     case DataPurpose::NORMAL_F3:
+    case DataPurpose::NORMAL_MATRIX_F9:
       return 3;
     case DataPurpose::COLOR_F4:
+    case DataPurpose::MODEL_MATRIX_F16:
+    case DataPurpose::COLOR_RGBA8:
+    case DataPurpose::NORMAL_SNORM_1010102:
       return 4;
     case DataPurpose::TEXTURE_COORDINATE_F2:
+    case DataPurpose::TEXTURE_COORDINATE_H2:
       return 2;
     case DataPurpose::TEX_ID_INT:
+    case DataPurpose::TEX_ID_U16:
       return 1;
     }
     Platform::Unreachable();
@@ -38,15 +45,55 @@ namespace
     case DataPurpose::COLOR_F4:
     case DataPurpose::TEXTURE_COORDINATE_F2:
     case DataPurpose::NORMAL_F3:
+    case DataPurpose::MODEL_MATRIX_F16:
+    case DataPurpose::NORMAL_MATRIX_F9:
       return GL_FLOAT;
+    case DataPurpose::COLOR_RGBA8:
+      return GL_UNSIGNED_BYTE;
+    case DataPurpose::TEXTURE_COORDINATE_H2:
+      return GL_HALF_FLOAT;
+    case DataPurpose::NORMAL_SNORM_1010102:
+      return GL_INT_2_10_10_10_REV;
     case DataPurpose::TEX_ID_INT:
       return GL_INT;
+    case DataPurpose::TEX_ID_U16:
+      return GL_UNSIGNED_SHORT;
     }
     Platform::Unreachable();
   }
+
+  /**
+   * Attributes read by the shaders as integers instead of being converted to floats
+   */
+  bool IsIntegerAttribute(DataPurpose type)
+  {
+    return type == DataPurpose::TEX_ID_INT || type == DataPurpose::TEX_ID_U16;
+  }
+
+  /**
+   * Matrices take one attribute location for each column
+   */
+  u32 GetLocationsCount(const BufferElem& e)
+  {
+    switch (e.purpose)
+    {
+    case DataPurpose::MODEL_MATRIX_F16:
+      return 4;
+    case DataPurpose::NORMAL_MATRIX_F9:
+      return 3;
+    default:
+      return 1;
+    }
+  }
 }
 
-VertexArray::VertexArray() : id(0), vertex_buffer(nullptr), index_buffer(nullptr)
+VertexArray::VertexArray() :
+    id(0),
+    vertex_buffer(nullptr),
+    index_buffer(nullptr),
+    instance_buffer(nullptr),
+    vertex_stream(nullptr),
+    index_stream(nullptr)
 {
   u32 v_id = 0;
   glCreateVertexArrays(1, &v_id);
@@ -57,49 +104,81 @@ VertexArray::~VertexArray()
 {
   const u32 v_id = u32(id);
   glDeleteVertexArrays(1, &v_id);
+  GLStateCache::Get().OnVertexArrayDeleted(v_id);
 }
 
 void VertexArray::Bind() const
 {
-  glBindVertexArray(u32(id));
-  if (vertex_buffer)
-    vertex_buffer->Bind();
-  if (index_buffer)
-    index_buffer->Bind();
+  // The attribute buffers and the index buffer are recorded in the VAO when they are set, so
+  // drawing only needs the VAO itself
+  GLStateCache::Get().BindVertexArray(u32(id));
 }
 
 void VertexArray::SetVertexBuffer(const Ptr<VertexBuffer>& vertexBuffer, BufferLayout layout)
 {
   GE_ASSERT(IsVAOBound(u32(id)), "The associated VAO lacks a binding");
 
-  u32 attrib_index = 0;
+  SetAttributes(layout, 0);
+  this->vertex_buffer = vertexBuffer;
+}
+
+void VertexArray::SetInstanceBuffer(const Ptr<VertexBuffer>& instanceBuffer, BufferLayout layout)
+{
+  GE_ASSERT(IsVAOBound(u32(id)), "The associated VAO lacks a binding");
+  GE_ASSERT(vertex_buffer != nullptr, "The vertex buffer must be set before the instance buffer");
+
+  instanceBuffer->Bind();
+  SetAttributes(layout, 1);
+  this->instance_buffer = instanceBuffer;
+}
+
+void VertexArray::SetStreamBuffers(const Ptr<StreamBuffer>& vertices,
+                                   const Ptr<StreamBuffer>& indices,
+                                   BufferLayout layout)
+{
+  GE_ASSERT(IsVAOBound(u32(id)), "The associated VAO lacks a binding");
+
+  GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, u32(vertices->GetID()));
+  SetAttributes(layout, 0);
+  GLStateCache::Get().BindBuffer(GL_ELEMENT_ARRAY_BUFFER, u32(indices->GetID()));
+  this->vertex_stream = vertices;
+  this->index_stream = indices;
+}
+
+void VertexArray::SetAttributes(const BufferLayout& layout, u32 divisor)
+{
   layout.ForEachElement(
     [&](auto&& elem)
     {
-      glEnableVertexAttribArray(attrib_index);
-      const std::size_t offset = elem.offset;
-      auto data_type = ShaderDataTypeToOpenGLBaseType(elem.purpose);
-      if (data_type == GL_FLOAT)
+      const auto data_type = ShaderDataTypeToOpenGLBaseType(elem.purpose);
+      const i32 components = GetComponentCount(elem);
+      const u64 location_size = elem.size / GetLocationsCount(elem);
+      for (u32 loc = 0; loc < GetLocationsCount(elem); loc++)
       {
-        glVertexAttribPointer(
-          attrib_index,
-          GetComponentCount(elem),
-          GL_FLOAT,
-          elem.normalized,
-          static_cast<i32>(layout.GetStride()),
-          reinterpret_cast<void*>(offset)); // NOLINT(*-pro-type-reinterpret-cast, *-no-int-to-ptr)
+        const std::size_t offset = elem.offset + loc * location_size;
+        glEnableVertexAttribArray(attributes_count);
+        if (IsIntegerAttribute(elem.purpose))
+        {
+          glVertexAttribIPointer(attributes_count,
+                                 components,
+                                 data_type,
+                                 static_cast<i32>(layout.GetStride()),
+                                 reinterpret_cast<void*>(offset));
+        }
+        else
+        {
+          glVertexAttribPointer(
+            attributes_count,
+            components,
+            data_type,
+            elem.normalized,
+            static_cast<i32>(layout.GetStride()),
+            reinterpret_cast<void*>(offset)); // NOLINT(*-pro-type-reinterpret-cast, *-no-int-to-ptr)
+        }
+        glVertexAttribDivisor(attributes_count, divisor);
+        attributes_count++;
       }
-      else if (data_type == GL_INT)
-      {
-        glVertexAttribIPointer(attrib_index,
-                               GetComponentCount(elem),
-                               GL_INT,
-                               static_cast<i32>(layout.GetStride()),
-                               reinterpret_cast<void*>(offset));
-      }
-      attrib_index++;
     });
-  this->vertex_buffer = vertexBuffer;
 }
 
 void VertexArray::SetIndexBuffer(const Ptr<IndexBuffer>& indexBuffer)
@@ -114,8 +193,8 @@ bool VertexArray::IsValid() const
 
 void VertexArray::Unbind() const
 {
-  if (IsVAOBound(u32(id)))
-    glBindVertexArray(0);
+  if (GLStateCache::Get().GetVertexArray() == u32(id))
+    GLStateCache::Get().BindVertexArray(0);
 }
 
 Ptr<VertexArray> VertexArray::Make()
@@ -5,6 +5,7 @@
 #include "ge_vertex_buffer.hpp"
 #include "renderer/ge_buffer_layout.hpp"
 #include "renderer/ge_index_buffer.hpp"
+#include "renderer/ge_stream_buffer.hpp"
 
 namespace GE
 {
@@ -23,12 +24,31 @@ namespace GE
     void SetVertexBuffer(const Ptr<VertexBuffer>& vertexBuffer, BufferLayout layout);
     void SetIndexBuffer(const Ptr<IndexBuffer>& indexBuffer);
 
+    /**
+     * Set a buffer whose attributes advance once per instance, placed after the vertex ones
+     */
+    void SetInstanceBuffer(const Ptr<VertexBuffer>& instanceBuffer, BufferLayout layout);
+
+    /**
+     * Read the vertices and the indices from streaming buffers. Draws select the current regions
+     * with their base vertex and their offset in the indices.
+     */
+    void SetStreamBuffers(const Ptr<StreamBuffer>& vertices,
+                          const Ptr<StreamBuffer>& indices,
+                          BufferLayout layout);
+
     [[nodiscard]] u32 GetID() const { return u32(id); }
 
   private:
+    void SetAttributes(const BufferLayout& layout, u32 divisor);
+
     RendererID id;
     Ptr<VertexBuffer> vertex_buffer;
     Ptr<IndexBuffer> index_buffer;
+    Ptr<VertexBuffer> instance_buffer;
+    Ptr<StreamBuffer> vertex_stream;
+    Ptr<StreamBuffer> index_stream;
+    u32 attributes_count = 0;
   };
 }
 
@@ -2,12 +2,14 @@
 
 #include "core/ge_assert.hpp"
 #include "renderer/ge_gl_checkers.hpp"
+#include "renderer/ge_gl_state_cache.hpp"
 
 #include <glad/glad.h>
 
 using namespace GE;
 
-VertexBuffer::VertexBuffer(const void* ptr, u64 verticesSize, RendererID parent)
+VertexBuffer::VertexBuffer(const void* ptr, u64 verticesSize, RendererID parent) :
+    m_capacity(verticesSize)
 {
   GE_ASSERT(IsVAOBound(u32(parent)), "The associated VAO lacks a binding");
 
@@ -16,7 +18,7 @@ VertexBuffer::VertexBuffer(const void* ptr, u64 verticesSize, RendererID parent)
   u32 id = 0;
   glGenBuffers(1, &id);
   m_id = RendererID{ id };
-  glBindBuffer(GL_ARRAY_BUFFER, id);
+  GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, id);
   glBufferData(GL_ARRAY_BUFFER, i64(verticesSize), ptr, GL_DYNAMIC_DRAW);
 }
 
@@ -24,19 +26,19 @@ void VertexBuffer::Bind() const
 {
   GE_ASSERT(IsVAOBound(u32(m_parent)), "The associated VAO lacks a binding");
 
-  glBindBuffer(GL_ARRAY_BUFFER, u32(m_id));
+  GLStateCache::Get().BindBuffer(GL_ARRAY_BUFFER, u32(m_id));
 }
 
-void VertexBuffer::UpdateData(const void* data, const u64 size) const
+void VertexBuffer::UpdateData(const void* data, const u64 size)
 {
-  Bind();
-  // Get current size
-  i32 curr_size = 0;
-  glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &curr_size);
-  if (size > u32(curr_size))
-    glBufferData(GL_ARRAY_BUFFER, static_cast<i64>(size), data, GL_DYNAMIC_DRAW);
+  // The capacity is tracked here, so the upload neither binds nor queries the buffer
+  if (size > m_capacity)
+  {
+    glNamedBufferData(u32(m_id), static_cast<i64>(size), data, GL_DYNAMIC_DRAW);
+    m_capacity = size;
+  }
   else
-    glBufferSubData(GL_ARRAY_BUFFER, 0, i64(size), data);
+    glNamedBufferSubData(u32(m_id), 0, i64(size), data);
 }
 
 Ptr<VertexBuffer> VertexBuffer::Make(const void* ptr, u64 verticesSize, RendererID parent)
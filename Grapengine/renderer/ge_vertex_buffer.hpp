@@ -12,11 +12,15 @@ namespace GE
 
     void Bind() const;
 
-    void UpdateData(const void* data, u64 size) const;
+    /**
+     * Replace the contents, reallocating the storage only when it must grow
+     */
+    void UpdateData(const void* data, u64 size);
 
   private:
     RendererID m_id = 0;
     RendererID m_parent = 0;
+    u64 m_capacity = 0;
   };
 }
 
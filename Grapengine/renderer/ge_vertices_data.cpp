@@ -1,7 +1,23 @@
 #include "ge_vertices_data.hpp"
 
+#include "math/ge_arithmetic.hpp"
+
 using namespace GE;
 
+namespace
+{
+  u8 ToUnorm8(f32 value)
+  {
+    return static_cast<u8>(std::lround(std::clamp(value, 0.0F, 1.0F) * 255.0F));
+  }
+
+  u32 ToSnorm10(f32 value)
+  {
+    const auto snorm = static_cast<i32>(std::lround(std::clamp(value, -1.0F, 1.0F) * 511.0F));
+    return static_cast<u32>(snorm) & 0x3FF;
+  }
+}
+
 Ptr<VerticesData> VerticesData::Make()
 {
   return MakeRef<VerticesData>();
@@ -30,26 +46,52 @@ BufferLayout VerticesData::GetLayout()
 {
   return BufferLayout{ BufferLayout::BuildElementsList({
     DataPurpose::POSITION_F3,
-    DataPurpose::TEXTURE_COORDINATE_F2,
-    DataPurpose::COLOR_F4,
-    DataPurpose::NORMAL_F3,
-    DataPurpose::TEX_ID_INT,
+    DataPurpose::TEXTURE_COORDINATE_H2,
+    DataPurpose::COLOR_RGBA8,
+    DataPurpose::NORMAL_SNORM_1010102,
+    DataPurpose::TEX_ID_U16,
   }) };
 }
 
-std::vector<VertexStruct>& VerticesData::GetData()
+PackedVertexStruct VerticesData::Pack(const VertexStruct& vs)
 {
-  return m_data;
+  GE_ASSERT(vs.texture_slot <= std::numeric_limits<u16>::max(), "Texture slot out of range");
+
+  PackedVertexStruct packed{};
+  packed.position = vs.position;
+  packed.texture_coord = { Arithmetic::ToHalfFloat(vs.texture_coord.x),
+                           Arithmetic::ToHalfFloat(vs.texture_coord.y) };
+  packed.color = {
+    ToUnorm8(vs.color.x0), ToUnorm8(vs.color.x1), ToUnorm8(vs.color.x2), ToUnorm8(vs.color.x3)
+  };
+  packed.normal =
+    ToSnorm10(vs.normal.x) | (ToSnorm10(vs.normal.y) << 10) | (ToSnorm10(vs.normal.z) << 20);
+  packed.texture_slot = static_cast<u16>(vs.texture_slot);
+  return packed;
 }
 
-const std::vector<VertexStruct>& VerticesData::GetData() const
+void VerticesData::Pack(std::span<const VertexStruct> vertices,
+                        std::span<PackedVertexStruct> packed)
+{
+  GE_ASSERT(vertices.size() == packed.size(), "Packed vertices size mismatch");
+  std::ranges::transform(vertices, packed.begin(), [](const VertexStruct& vs) { return Pack(vs); });
+}
+
+std::vector<PackedVertexStruct> VerticesData::GetPacked() const
+{
+  std::vector<PackedVertexStruct> packed(m_data.size());
+  Pack(m_data, packed);
+  return packed;
+}
+
+std::vector<VertexStruct>& VerticesData::GetData()
 {
   return m_data;
 }
 
-void VerticesData::SortVertices()
+const std::vector<VertexStruct>& VerticesData::GetData() const
 {
-  std::ranges::sort(m_data);
+  return m_data;
 }
 
 void VerticesData::Clear()
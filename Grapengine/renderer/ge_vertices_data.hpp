@@ -11,8 +11,14 @@ namespace GE
   public:
     static Ptr<VerticesData> Make();
 
+    /**
+     * Layout of the packed vertices uploaded to the GPU
+     */
     [[nodiscard]] static BufferLayout GetLayout();
 
+    [[nodiscard]] static PackedVertexStruct Pack(const VertexStruct& vs);
+    static void Pack(std::span<const VertexStruct> vertices, std::span<PackedVertexStruct> packed);
+
     explicit VerticesData(const std::vector<VertexStruct>& vertices = {});
 
     void PushVerticesData(VertexStruct&& vs);
@@ -23,6 +29,8 @@ namespace GE
 
     [[nodiscard]] const VertexStruct* GetPtr() const;
 
+    [[nodiscard]] std::vector<PackedVertexStruct> GetPacked() const;
+
     void RawPushData(VerticesData&& data);
 
     void Clear();
@@ -30,8 +38,6 @@ namespace GE
     std::vector<VertexStruct>& GetData();
     const std::vector<VertexStruct>& GetData() const;
 
-    void SortVertices();
-
     bool operator==(const VerticesData& other) const = default;
 
   private:
@@ -1,54 +1,57 @@
 #ifndef GRAPENGINE_MATERIAL_SHADER_HPP
 #define GRAPENGINE_MATERIAL_SHADER_HPP
 
-#include "drawables/ge_color.hpp"
 #include "math/ge_vector.hpp"
 #include "renderer/ge_ishader_program.hpp"
-#include "renderer/ge_light_source.hpp"
 #include "renderer/ge_shader.hpp"
 
 namespace GE
 {
+  /**
+   * Where the material shader reads the model transform, color and texture of the objects from
+   */
+  enum class MaterialInput : u8
+  {
+    BATCHED_VERTICES,
+    INSTANCES
+  };
+
+  /**
+   * Whether the material shader lights the objects, or draws them with their own color, as the
+   * gizmos of the light sources
+   */
+  enum class MaterialShading : u8
+  {
+    LIT,
+    UNLIT
+  };
+
   class MaterialShader final : public IShaderProgram
   {
   public:
-    static Ptr<MaterialShader> Make();
+    static Ptr<MaterialShader> Make(MaterialInput input = MaterialInput::BATCHED_VERTICES,
+                                    MaterialShading shading = MaterialShading::LIT);
 
-    MaterialShader();
+    explicit MaterialShader(MaterialInput input = MaterialInput::BATCHED_VERTICES,
+                            MaterialShading shading = MaterialShading::LIT);
     ~MaterialShader() override;
 
     void Activate() override;
     void Deactivate() override;
 
-    void UpdateViewProjectionMatrix(const Mat4& viewProj, const Vec3& viewPosition) override;
-    void UpdateTexture(int id) override;
-    void UpdateTextures(const std::vector<i32>& textures);
-
     /**
-     * Update ambient light properties
-     * @param color light color
-     * @param strength light strenght limited from 0 to 10
+     * Camera, lights and texture layers are read from the uniform blocks of FrameUniforms, shared
+     * by every material shader
      */
-    void UpdateAmbientLight(Color color, f32 strength);
-    //    void ClearAmbientLight();
+    void UpdateViewProjectionMatrix(const Mat4& viewProj, const Vec3& viewPosition) override;
 
     /**
-     *
-     * @param lightSources lights properties
+     * Texture array sampled by the next draw, which all of its texture slots must be in
+     * @param id index of the texture array
      */
-    void UpdateLightSources(const std::vector<LightSource>& lightSources);
-    //    void ClearLightSources();
+    void UpdateTexture(int id) override;
 
   private:
-    void UpdateAmbientColor(Color color);
-    void UpdateAmbientStrength(f32 strength);
-
-    void UpdateLightPosition(const std::vector<Vec3>& pos);
-    void UpdateLightColor(const std::vector<Vec3>& color);
-    void UpdateLightStrength(const std::vector<f32>& strength);
-
-    void UpdateViewPosition(const Vec3& pos);
-
     Ptr<Shader> m_shader;
   };
 }
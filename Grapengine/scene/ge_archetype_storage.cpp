@@ -0,0 +1,247 @@
+#include "scene/ge_archetype_storage.hpp"
+
+#include "profiling/ge_profiler.hpp"
+
+using namespace GE;
+
+namespace
+{
+  u64 AlignUp(u64 offset, u64 alignment)
+  {
+    return (offset + alignment - 1) / alignment * alignment;
+  }
+
+  u64 ArchetypeKey(ComponentSignature signature, bool enabled)
+  {
+    return (static_cast<u64>(enabled) << 32) | signature;
+  }
+}
+
+ArchetypeStorage::~ArchetypeStorage()
+{
+  for (const Archetype& arch : m_archetypes)
+  {
+    for (const Chunk& chunk : arch.chunks)
+    {
+      ForEachComponentType(arch.signature,
+                           [&]<typename Component>(std::type_identity<Component>)
+                           {
+                             auto* components = reinterpret_cast<Component*>(
+                               chunk.data.get() + arch.layout.components[ComponentID<Component>]);
+                             std::destroy_n(components, chunk.count);
+                           });
+    }
+  }
+}
+
+void ArchetypeStorage::Insert(Entity ent)
+{
+  GE_PROFILE;
+  const u32 slot = ent.Index();
+  if (slot >= m_locations.size())
+    m_locations.resize(slot + 1);
+
+  GE_ASSERT(m_locations[slot].archetype == INVALID_INDEX, "Slot already in use!");
+  m_locations[slot] = PushRow(GetArchetype(0, true), ent);
+}
+
+void ArchetypeStorage::Erase(u32 slot)
+{
+  GE_PROFILE;
+  if (slot >= m_locations.size() || m_locations[slot].archetype == INVALID_INDEX)
+    return;
+
+  EraseRow(m_locations[slot]);
+  m_locations[slot] = Location{};
+}
+
+void ArchetypeStorage::SetEnabled(u32 slot, bool enabled)
+{
+  GE_PROFILE;
+  const ComponentSignature signature = m_archetypes[m_locations[slot].archetype].signature;
+  MoveSlot(slot, GetArchetype(signature, enabled));
+}
+
+void ArchetypeStorage::Copy(u32 slot, u32 source, u64 version)
+{
+  GE_PROFILE;
+  GE_ASSERT(m_archetypes[m_locations[slot].archetype].signature == 0,
+            "Slot already has components!");
+
+  const ComponentSignature signature = m_archetypes[m_locations[source].archetype].signature;
+  const bool enabled = m_archetypes[m_locations[slot].archetype].enabled;
+  MoveSlot(slot, GetArchetype(signature, enabled));
+
+  const Location& to = m_locations[slot];
+  const Location& from = m_locations[source];
+  const ChunkRef to_chunk{ to.archetype, to.chunk };
+  const ChunkRef from_chunk{ from.archetype, from.chunk };
+  ForEachComponentType(signature,
+                       [&]<typename Component>(std::type_identity<Component>)
+                       {
+                         const Component& component = Components<Component>(from_chunk)[from.row];
+                         std::construct_at(Components<Component>(to_chunk) + to.row, component);
+                         Versions<Component>(to_chunk)[to.row] = version;
+                       });
+}
+
+std::vector<ArchetypeStorage::ChunkRef> ArchetypeStorage::GetChunks(ComponentSignature mask) const
+{
+  GE_PROFILE;
+  std::vector<ChunkRef> chunks;
+  for (u32 i = 0; i < m_archetypes.size(); i++)
+  {
+    const Archetype& arch = m_archetypes[i];
+    if (!arch.enabled || (arch.signature & mask) != mask)
+      continue;
+
+    for (u32 j = 0; j < arch.chunks.size(); j++)
+      chunks.push_back({ i, j });
+  }
+  return chunks;
+}
+
+u32 ArchetypeStorage::Count(const ChunkRef& chunk) const
+{
+  return m_archetypes[chunk.archetype].chunks[chunk.chunk].count;
+}
+
+const Entity* ArchetypeStorage::Entities(const ChunkRef& chunk) const
+{
+  return reinterpret_cast<const Entity*>(Data(chunk));
+}
+
+ArchetypeStorage::ChunkLayout ArchetypeStorage::MakeLayout(ComponentSignature signature)
+{
+  u64 row_bytes = sizeof(Entity);
+  ForEachComponentType(signature,
+                       [&]<typename Component>(std::type_identity<Component>)
+                       {
+                         static_assert(alignof(Component) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                                       "Component cannot be aligned inside a chunk");
+                         row_bytes += sizeof(Component) + sizeof(u64);
+                       });
+
+  // Entities array first, then one array for each component followed by its versions
+  ChunkLayout layout;
+  layout.capacity = static_cast<u32>(std::max<u64>(CHUNK_BYTES / row_bytes, 1));
+  while (true)
+  {
+    u64 offset = sizeof(Entity) * layout.capacity;
+    ForEachComponentType(signature,
+                         [&]<typename Component>(std::type_identity<Component>)
+                         {
+                           offset = AlignUp(offset, alignof(Component));
+                           layout.components[ComponentID<Component>] = offset;
+                           offset += sizeof(Component) * layout.capacity;
+                           offset = AlignUp(offset, alignof(u64));
+                           layout.versions[ComponentID<Component>] = offset;
+                           offset += sizeof(u64) * layout.capacity;
+                         });
+    layout.bytes = offset;
+
+    // Alignment padding may overflow the chunk size
+    if (layout.bytes <= CHUNK_BYTES || layout.capacity == 1)
+      return layout;
+    layout.capacity--;
+  }
+}
+
+std::byte* ArchetypeStorage::Data(const ChunkRef& chunk) const
+{
+  return m_archetypes[chunk.archetype].chunks[chunk.chunk].data.get();
+}
+
+const ArchetypeStorage::ChunkLayout& ArchetypeStorage::Layout(const ChunkRef& chunk) const
+{
+  return m_archetypes[chunk.archetype].layout;
+}
+
+u32 ArchetypeStorage::GetArchetype(ComponentSignature signature, bool enabled)
+{
+  const u64 key = ArchetypeKey(signature, enabled);
+  if (auto it = m_archetypes_indices.find(key); it != m_archetypes_indices.end())
+    return it->second;
+
+  const auto index = static_cast<u32>(m_archetypes.size());
+  m_archetypes.push_back({ signature, enabled, MakeLayout(signature), {} });
+  m_archetypes_indices.emplace(key, index);
+  return index;
+}
+
+ArchetypeStorage::Location ArchetypeStorage::PushRow(u32 archetype, Entity ent)
+{
+  Archetype& arch = m_archetypes[archetype];
+  if (arch.chunks.empty() || arch.chunks.back().count == arch.layout.capacity)
+    arch.chunks.push_back({ std::make_unique<std::byte[]>(arch.layout.bytes), 0 });
+
+  const auto chunk = static_cast<u32>(arch.chunks.size() - 1);
+  const u32 row = arch.chunks.back().count++;
+  std::construct_at(reinterpret_cast<Entity*>(arch.chunks.back().data.get()) + row, ent);
+  return { archetype, chunk, row };
+}
+
+void ArchetypeStorage::MoveSlot(u32 slot, u32 archetype)
+{
+  const Location from = m_locations[slot];
+  if (from.archetype == archetype)
+    return;
+
+  const Entity ent = Entities({ from.archetype, from.chunk })[from.row];
+  const Location to = PushRow(archetype, ent);
+
+  // Only the components that both archetypes have are carried to the new row
+  const ComponentSignature shared =
+    m_archetypes[from.archetype].signature & m_archetypes[archetype].signature;
+  const ChunkRef from_chunk{ from.archetype, from.chunk };
+  const ChunkRef to_chunk{ to.archetype, to.chunk };
+  ForEachComponentType(shared,
+                       [&]<typename Component>(std::type_identity<Component>)
+                       {
+                         Component& component = Components<Component>(from_chunk)[from.row];
+                         std::construct_at(Components<Component>(to_chunk) + to.row,
+                                           std::move(component));
+                         Versions<Component>(to_chunk)[to.row] =
+                           Versions<Component>(from_chunk)[from.row];
+                       });
+
+  m_locations[slot] = to;
+  EraseRow(from);
+}
+
+void ArchetypeStorage::EraseRow(const Location& loc)
+{
+  Archetype& arch = m_archetypes[loc.archetype];
+  const auto last_chunk = static_cast<u32>(arch.chunks.size() - 1);
+  const u32 last_row = arch.chunks.back().count - 1;
+  const ChunkRef chunk{ loc.archetype, loc.chunk };
+  const ChunkRef last{ loc.archetype, last_chunk };
+  const bool is_last = loc.chunk == last_chunk && loc.row == last_row;
+
+  // The last row of the archetype is moved to the erased one, so chunks stay packed
+  ForEachComponentType(arch.signature,
+                       [&]<typename Component>(std::type_identity<Component>)
+                       {
+                         Component* components = Components<Component>(chunk);
+                         std::destroy_at(components + loc.row);
+                         if (is_last)
+                           return;
+
+                         Component* last_components = Components<Component>(last);
+                         std::construct_at(components + loc.row,
+                                           std::move(last_components[last_row]));
+                         std::destroy_at(last_components + last_row);
+                         u64* versions = Versions<Component>(chunk);
+                         versions[loc.row] = Versions<Component>(last)[last_row];
+                       });
+
+  if (!is_last)
+  {
+    const Entity moved = Entities(last)[last_row];
+    reinterpret_cast<Entity*>(Data(chunk))[loc.row] = moved;
+    m_locations[moved.Index()] = loc;
+  }
+
+  if (--arch.chunks.back().count == 0)
+    arch.chunks.pop_back();
+}
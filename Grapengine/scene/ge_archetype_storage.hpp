@@ -0,0 +1,246 @@
+#ifndef GRAPENGINE_GE_ARCHETYPE_STORAGE_HPP
+#define GRAPENGINE_GE_ARCHETYPE_STORAGE_HPP
+
+#include "ge_components.hpp"
+#include "ge_entity.hpp"
+
+namespace GE
+{
+  /**
+   * Call the function with a std::type_identity of each component type in the signature
+   */
+  template <typename Fun>
+  void ForEachComponentType(ComponentSignature signature, Fun&& fun)
+  {
+    [&]<typename... Comps>(std::type_identity<std::variant<Comps...>>)
+    {
+      (...,
+       [&]
+       {
+         if ((signature & ComponentMask<Comps>) != 0)
+           fun(std::type_identity<Comps>{});
+       }());
+    }(std::type_identity<VarComponent>{});
+  }
+
+  /**
+   * Archetype storage of components.
+   * Entities with the same signature and enabled state share an archetype, where they are packed
+   * in fixed-size chunks. A chunk holds parallel arrays, one for the entities and one for each
+   * component of the signature (and its versions), so queries over many components iterate
+   * tightly packed arrays.
+   */
+  class ArchetypeStorage
+  {
+  public:
+    static constexpr u64 CHUNK_BYTES = 16 * 1024;
+
+    /**
+     * Reference to a chunk of an archetype
+     */
+    struct ChunkRef
+    {
+      u32 archetype;
+      u32 chunk;
+    };
+
+    ArchetypeStorage() = default;
+    ~ArchetypeStorage();
+
+    ArchetypeStorage(const ArchetypeStorage&) = delete;
+    ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+    ArchetypeStorage(ArchetypeStorage&&) noexcept = default;
+
+    /**
+     * Insert an enabled entity without components
+     */
+    void Insert(Entity ent);
+
+    /**
+     * Erase the entity of the slot, destroying its components
+     */
+    void Erase(u32 slot);
+
+    void SetEnabled(u32 slot, bool enabled);
+
+    /**
+     * Give to the slot, which must have no components, a copy of the components of another slot
+     * @param slot registry slot that receives the copies
+     * @param source registry slot whose components are copied
+     * @param version version that stamps the copied components
+     */
+    void Copy(u32 slot, u32 source, u64 version);
+
+    template <typename Component>
+    [[nodiscard]] bool Has(u32 slot) const
+    {
+      if (slot >= m_locations.size() || m_locations[slot].archetype == INVALID_INDEX)
+        return false;
+
+      return (m_archetypes[m_locations[slot].archetype].signature & ComponentMask<Component>) != 0;
+    }
+
+    /**
+     * Construct the component of the slot, moving the entity to the archetype that includes it
+     */
+    template <typename Component, typename... Args>
+    Component& Emplace(u32 slot, u64 version, Args&&... args)
+    {
+      GE_ASSERT(!Has<Component>(slot), "Slot already has this component!");
+
+      const Archetype& current = m_archetypes[m_locations[slot].archetype];
+      const ComponentSignature signature = current.signature | ComponentMask<Component>;
+      const bool enabled = current.enabled;
+      MoveSlot(slot, GetArchetype(signature, enabled));
+
+      const Location& loc = m_locations[slot];
+      const ChunkRef chunk{ loc.archetype, loc.chunk };
+      Versions<Component>(chunk)[loc.row] = version;
+      return *std::construct_at(Components<Component>(chunk) + loc.row,
+                                std::forward<Args>(args)...);
+    }
+
+    template <typename Component>
+    void Remove(u32 slot)
+    {
+      if (!Has<Component>(slot))
+        return;
+
+      const Archetype& current = m_archetypes[m_locations[slot].archetype];
+      const ComponentSignature signature = current.signature & ~ComponentMask<Component>;
+      const bool enabled = current.enabled;
+      MoveSlot(slot, GetArchetype(signature, enabled));
+    }
+
+    template <typename Component>
+    [[nodiscard]] Component& Get(u32 slot)
+    {
+      GE_ASSERT(Has<Component>(slot), "Slot does not have this component!");
+      const Location& loc = m_locations[slot];
+      return Components<Component>({ loc.archetype, loc.chunk })[loc.row];
+    }
+
+    template <typename Component>
+    [[nodiscard]] const Component& Get(u32 slot) const
+    {
+      GE_ASSERT(Has<Component>(slot), "Slot does not have this component!");
+      const Location& loc = m_locations[slot];
+      return Components<Component>({ loc.archetype, loc.chunk })[loc.row];
+    }
+
+    /**
+     * Mark the component of the slot as changed at the given version
+     */
+    template <typename Component>
+    void Touch(u32 slot, u64 version)
+    {
+      GE_ASSERT(Has<Component>(slot), "Slot does not have this component!");
+      const Location& loc = m_locations[slot];
+      Versions<Component>({ loc.archetype, loc.chunk })[loc.row] = version;
+    }
+
+    /**
+     * Version of the last change of the component of the slot
+     */
+    template <typename Component>
+    [[nodiscard]] u64 GetVersion(u32 slot) const
+    {
+      GE_ASSERT(Has<Component>(slot), "Slot does not have this component!");
+      const Location& loc = m_locations[slot];
+      return Versions<Component>({ loc.archetype, loc.chunk })[loc.row];
+    }
+
+    /**
+     * Call the visitor with each component of the slot
+     */
+    template <typename Visitor>
+    void Visit(u32 slot, Visitor&& visitor) const
+    {
+      const Location& loc = m_locations[slot];
+      if (loc.archetype == INVALID_INDEX)
+        return;
+
+      const ChunkRef chunk{ loc.archetype, loc.chunk };
+      ForEachComponentType(m_archetypes[loc.archetype].signature,
+                           [&]<typename Component>(std::type_identity<Component>)
+                           {
+                             const Component* components = Components<Component>(chunk);
+                             visitor(components[loc.row]);
+                           });
+    }
+
+    /**
+     * Chunks of the enabled archetypes whose signature contains the mask
+     */
+    [[nodiscard]] std::vector<ChunkRef> GetChunks(ComponentSignature mask) const;
+
+    [[nodiscard]] u32 Count(const ChunkRef& chunk) const;
+    [[nodiscard]] const Entity* Entities(const ChunkRef& chunk) const;
+
+    template <typename Component>
+    [[nodiscard]] Component* Components(const ChunkRef& chunk) const
+    {
+      const u64 offset = Layout(chunk).components[ComponentID<Component>];
+      return reinterpret_cast<Component*>(Data(chunk) + offset);
+    }
+
+    template <typename Component>
+    [[nodiscard]] u64* Versions(const ChunkRef& chunk) const
+    {
+      const u64 offset = Layout(chunk).versions[ComponentID<Component>];
+      return reinterpret_cast<u64*>(Data(chunk) + offset);
+    }
+
+  private:
+    static constexpr u32 INVALID_INDEX = std::numeric_limits<u32>::max();
+    static constexpr u64 COMPONENTS_COUNT = std::variant_size_v<VarComponent>;
+
+    /**
+     * Byte offsets of the arrays of a chunk
+     */
+    struct ChunkLayout
+    {
+      u32 capacity = 0;
+      u64 bytes = 0;
+      std::array<u64, COMPONENTS_COUNT> components{};
+      std::array<u64, COMPONENTS_COUNT> versions{};
+    };
+
+    struct Chunk
+    {
+      Scope<std::byte[]> data;
+      u32 count = 0;
+    };
+
+    struct Archetype
+    {
+      ComponentSignature signature;
+      bool enabled;
+      ChunkLayout layout;
+      std::vector<Chunk> chunks;
+    };
+
+    struct Location
+    {
+      u32 archetype = INVALID_INDEX;
+      u32 chunk = 0;
+      u32 row = 0;
+    };
+
+    static ChunkLayout MakeLayout(ComponentSignature signature);
+
+    [[nodiscard]] std::byte* Data(const ChunkRef& chunk) const;
+    [[nodiscard]] const ChunkLayout& Layout(const ChunkRef& chunk) const;
+
+    u32 GetArchetype(ComponentSignature signature, bool enabled);
+    Location PushRow(u32 archetype, Entity ent);
+    void MoveSlot(u32 slot, u32 archetype);
+    void EraseRow(const Location& loc);
+
+    std::vector<Archetype> m_archetypes;
+    std::unordered_map<u64, u32> m_archetypes_indices;
+    std::vector<Location> m_locations;
+  };
+}
+
+#endif // GRAPENGINE_GE_ARCHETYPE_STORAGE_HPP
@@ -0,0 +1,61 @@
+#include "scene/ge_command_buffer.hpp"
+
+#include "profiling/ge_profiler.hpp"
+
+using namespace GE;
+
+void CommandBuffer::Create(std::function<void(Entity)>&& onCreated)
+{
+  Record(Rank::CREATE,
+         std::nullopt,
+         [fun = std::move(onCreated)](ECRegistry& registry)
+         {
+           const Entity ent = registry.Create();
+           if (fun)
+             fun(ent);
+         });
+}
+
+void CommandBuffer::Destroy(Entity ent)
+{
+  Record(Rank::DESTROY, ent, [ent](ECRegistry& registry) { registry.Destroy(ent); });
+}
+
+void CommandBuffer::Playback(ECRegistry& registry)
+{
+  GE_PROFILE;
+  while (true)
+  {
+    {
+      const std::scoped_lock lock{ m_mutex };
+      if (m_commands.empty())
+        return;
+
+      m_playing.swap(m_commands);
+    }
+
+    // Commands of the same rank and entity keep the order they were recorded
+    std::ranges::stable_sort(m_playing,
+                             [](const Command& lhs, const Command& rhs)
+                             {
+                               return std::tie(lhs.rank, lhs.entity_index) <
+                                      std::tie(rhs.rank, rhs.entity_index);
+                             });
+    for (Command& cmd : m_playing)
+      cmd.apply(registry);
+    m_playing.clear();
+  }
+}
+
+bool CommandBuffer::IsEmpty() const
+{
+  const std::scoped_lock lock{ m_mutex };
+  return m_commands.empty();
+}
+
+void CommandBuffer::Record(Rank rank, Opt<Entity> ent, std::function<void(ECRegistry&)>&& apply)
+{
+  const u32 entity_index = ent ? ent->Index() : 0;
+  const std::scoped_lock lock{ m_mutex };
+  m_commands.push_back({ rank, entity_index, std::move(apply) });
+}
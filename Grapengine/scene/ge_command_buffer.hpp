@@ -0,0 +1,89 @@
+#ifndef GRAPENGINE_GE_COMMAND_BUFFER_HPP
+#define GRAPENGINE_GE_COMMAND_BUFFER_HPP
+
+#include "ge_ec_registry.hpp"
+
+namespace GE
+{
+  /**
+   * Thread safe recorder of structural changes in a registry.
+   * Commands can be recorded from any thread and are applied at once, on the thread that calls
+   * Playback, with creations first, then component changes and destructions last.
+   */
+  class CommandBuffer
+  {
+  public:
+    /**
+     * Record the creation of an entity
+     * @param onCreated function called with the created entity during playback
+     */
+    void Create(std::function<void(Entity)>&& onCreated);
+
+    void Destroy(Entity ent);
+
+    /**
+     * Record the addition of a component, which replaces the existing one of the same type
+     * @tparam Component type of component
+     * @param ent entity that is associated of component
+     * @param component component to be added
+     */
+    template <typename Component>
+    void AddComponent(Entity ent, Component component)
+    {
+      Record(Rank::CHANGE,
+             ent,
+             [ent, comp = std::move(component)](ECRegistry& registry) mutable
+             {
+               if (!registry.IsValid(ent))
+                 return;
+
+               if (registry.Has<Component>(ent))
+                 registry.RemoveComponent<Component>(ent);
+               registry.PushComponent<Component>(ent, std::move(comp));
+             });
+    }
+
+    template <typename Component>
+    void RemoveComponent(Entity ent)
+    {
+      Record(Rank::CHANGE,
+             ent,
+             [ent](ECRegistry& registry)
+             {
+               if (registry.Has<Component>(ent))
+                 registry.RemoveComponent<Component>(ent);
+             });
+    }
+
+    /**
+     * Apply and discard all recorded commands, including the ones recorded while applying them
+     * @param registry registry changed by the commands
+     */
+    void Playback(ECRegistry& registry);
+
+    [[nodiscard]] bool IsEmpty() const;
+
+  private:
+    enum class Rank : u8
+    {
+      CREATE,
+      CHANGE,
+      DESTROY,
+    };
+
+    struct Command
+    {
+      Rank rank;
+      u32 entity_index;
+      std::function<void(ECRegistry&)> apply;
+    };
+
+    void Record(Rank rank, Opt<Entity> ent, std::function<void(ECRegistry&)>&& apply);
+
+    mutable std::mutex m_mutex;
+    std::vector<Command> m_commands;
+    std::vector<Command> m_playing;
+  };
+}
+
+#endif // GRAPENGINE_GE_COMMAND_BUFFER_HPP
@@ -0,0 +1,132 @@
+#ifndef GRAPENGINE_GE_COMPONENT_POOL_HPP
+#define GRAPENGINE_GE_COMPONENT_POOL_HPP
+
+#include "core/ge_type_aliases.hpp"
+
+namespace GE
+{
+  /**
+   * Sparse set storage of a single component type.
+   * Components are tightly packed in a dense array, and a sparse array maps the registry slot of
+   * an entity to the position of its component in the dense array.
+   * @tparam Component type of component stored
+   */
+  template <typename Component>
+  class ComponentPool
+  {
+  public:
+    static constexpr u32 INVALID_INDEX = std::numeric_limits<u32>::max();
+
+    [[nodiscard]] bool Has(u32 slot) const
+    {
+      return slot < m_sparse.size() && m_sparse[slot] != INVALID_INDEX;
+    }
+
+    /**
+     * Construct the component of the slot, which is considered changed at the given version
+     */
+    template <typename... Args>
+    Component& Emplace(u32 slot, u64 version, Args&&... args)
+    {
+      GE_ASSERT(!Has(slot), "Slot already has this component!");
+
+      if (slot >= m_sparse.size())
+        m_sparse.resize(slot + 1, INVALID_INDEX);
+
+      m_sparse[slot] = static_cast<u32>(m_dense.size());
+      m_slots.push_back(slot);
+      m_versions.push_back(version);
+      return m_dense.emplace_back(std::forward<Args>(args)...);
+    }
+
+    /**
+     * Remove the component of the slot by moving the last component to its place
+     * @param slot registry slot whose component is removed
+     */
+    void Remove(u32 slot)
+    {
+      if (!Has(slot))
+        return;
+
+      const u32 idx = m_sparse[slot];
+      const u32 last_idx = static_cast<u32>(m_dense.size() - 1);
+      if (idx != last_idx)
+      {
+        m_dense[idx] = std::move(m_dense[last_idx]);
+        m_slots[idx] = m_slots[last_idx];
+        m_versions[idx] = m_versions[last_idx];
+        m_sparse[m_slots[idx]] = idx;
+      }
+      m_dense.pop_back();
+      m_slots.pop_back();
+      m_versions.pop_back();
+      m_sparse[slot] = INVALID_INDEX;
+    }
+
+    [[nodiscard]] Component& Get(u32 slot)
+    {
+      GE_ASSERT(Has(slot), "Slot does not have this component!");
+      return m_dense[m_sparse[slot]];
+    }
+
+    [[nodiscard]] const Component& Get(u32 slot) const
+    {
+      GE_ASSERT(Has(slot), "Slot does not have this component!");
+      return m_dense[m_sparse[slot]];
+    }
+
+    /**
+     * Mark the component of the slot as changed at the given version
+     */
+    void Touch(u32 slot, u64 version)
+    {
+      GE_ASSERT(Has(slot), "Slot does not have this component!");
+      m_versions[m_sparse[slot]] = version;
+    }
+
+    /**
+     * Version of the last change of the component of the slot
+     */
+    [[nodiscard]] u64 GetVersion(u32 slot) const
+    {
+      GE_ASSERT(Has(slot), "Slot does not have this component!");
+      return m_versions[m_sparse[slot]];
+    }
+
+    void Reserve(u64 size)
+    {
+      m_slots.reserve(size);
+      m_versions.reserve(size);
+      m_dense.reserve(size);
+    }
+
+    [[nodiscard]] u64 Size() const { return m_dense.size(); }
+
+    /**
+     * Registry slots that own the components, in the same order of the dense array
+     */
+    [[nodiscard]] const std::vector<u32>& GetSlots() const { return m_slots; }
+    [[nodiscard]] const std::vector<Component>& GetComponents() const { return m_dense; }
+    [[nodiscard]] std::vector<Component>& GetComponents() { return m_dense; }
+
+  private:
+    std::vector<u32> m_sparse;
+    std::vector<u32> m_slots;
+    std::vector<u64> m_versions;
+    std::vector<Component> m_dense;
+  };
+
+  /**
+   * Tuple of pools with one pool for each alternative of a variant of components
+   */
+  template <typename Variant>
+  struct ComponentPoolsOf;
+
+  template <typename... Components>
+  struct ComponentPoolsOf<std::variant<Components...>>
+  {
+    using Type = std::tuple<ComponentPool<Components>...>;
+  };
+}
+
+#endif // GRAPENGINE_GE_COMPONENT_POOL_HPP
@@ -11,6 +11,8 @@ TagComponent::TagComponent(std::string&& t) : m_tag(std::move(t)) {}
 PrimitiveComponent::PrimitiveComponent(const Drawable& dra, Color c, u32 texSlot) :
     m_drawable(dra), m_color(c), m_texture_slot(texSlot)
 {
+  m_drawable.UpdateColor(m_color);
+  m_drawable.UpdateTexture(m_texture_slot);
 }
 const Drawable& PrimitiveComponent::GetDrawable() const
 {
@@ -33,11 +35,13 @@ u32 PrimitiveComponent::GetTexSlot() const
 void PrimitiveComponent::SetColor(Color c)
 {
   m_color = c;
+  m_drawable.UpdateColor(m_color);
 }
 
 void PrimitiveComponent::SetTexSlot(u32 slot)
 {
   m_texture_slot = slot;
+  m_drawable.UpdateTexture(m_texture_slot);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -59,6 +63,55 @@ NativeScriptComponent::NativeScriptComponent() :
 {
 }
 
+NativeScriptComponent::NativeScriptComponent(const NativeScriptComponent& other) :
+    m_instance(nullptr),
+    m_instantiate_fun(other.m_instantiate_fun),
+    m_destroy_fun(other.m_destroy_fun)
+{
+}
+
+NativeScriptComponent& NativeScriptComponent::operator=(const NativeScriptComponent& other)
+{
+  if (this == &other)
+    return *this;
+
+  DestroyInstance();
+  m_instantiate_fun = other.m_instantiate_fun;
+  m_destroy_fun = other.m_destroy_fun;
+  return *this;
+}
+
+NativeScriptComponent::NativeScriptComponent(NativeScriptComponent&& other) noexcept :
+    m_instance(std::exchange(other.m_instance, nullptr)),
+    m_instantiate_fun(std::move(other.m_instantiate_fun)),
+    m_destroy_fun(std::move(other.m_destroy_fun))
+{
+}
+
+NativeScriptComponent& NativeScriptComponent::operator=(NativeScriptComponent&& other) noexcept
+{
+  if (this == &other)
+    return *this;
+
+  DestroyInstance();
+  m_instance = std::exchange(other.m_instance, nullptr);
+  m_instantiate_fun = std::move(other.m_instantiate_fun);
+  m_destroy_fun = std::move(other.m_destroy_fun);
+  return *this;
+}
+
+NativeScriptComponent::~NativeScriptComponent()
+{
+  DestroyInstance();
+}
+
+void NativeScriptComponent::DestroyInstance()
+{
+  if (m_instance != nullptr && m_destroy_fun)
+    m_destroy_fun(m_instance);
+  m_instance = nullptr;
+}
+
 //----------------------------------------------------------------------------------------------
 AmbientLightComponent::AmbientLightComponent(Color c, f32 str) : AmbientLightComponent(c, str, true)
 {
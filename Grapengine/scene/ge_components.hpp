@@ -120,27 +120,41 @@ namespace GE
   public:
     explicit NativeScriptComponent();
 
+    /**
+     * Copies share the script binding but not its instance, which is created for each entity.
+     * The instance is owned by the component, and moves transfer it.
+     */
+    NativeScriptComponent(const NativeScriptComponent& other);
+    NativeScriptComponent& operator=(const NativeScriptComponent& other);
+    NativeScriptComponent(NativeScriptComponent&& other) noexcept;
+    NativeScriptComponent& operator=(NativeScriptComponent&& other) noexcept;
+    ~NativeScriptComponent();
+
     template <typename T, typename... Args>
     void Bind(Args... args)
     {
-      m_instantiate_fun = [&](Entity e, Scene& s) { m_instance = new T(e, std::ref(s), std::forward<Args>(args)...); };
-      m_destroy_fun = [this]()
-      {
-        delete static_cast<T*>(m_instance);
-        m_instance = nullptr;
-      };
+      // Functions do not capture 'this' since the component is moved around inside its pool
+      m_instantiate_fun = [args...](Entity e, Scene& s) -> ScriptableEntity*
+      { return new T(e, std::ref(s), args...); };
+      m_destroy_fun = [](ScriptableEntity* instance) { delete static_cast<T*>(instance); };
     }
 
     [[nodiscard]] bool IsValid() const { return m_instance != nullptr; }
-    void Instantiate(Entity ent, Scene& scene) const { m_instantiate_fun(ent, scene); }
+    void Instantiate(Entity ent, Scene& scene)
+    {
+      DestroyInstance();
+      m_instance = m_instantiate_fun(ent, scene);
+    }
     [[nodiscard]] ScriptableEntity* GetInstance() const { return m_instance; }
 
     bool operator==(const NativeScriptComponent&) const { return false; }
 
   private:
+    void DestroyInstance();
+
     ScriptableEntity* m_instance;
-    std::function<void(Entity, Scene&)> m_instantiate_fun;
-    std::function<void()> m_destroy_fun;
+    std::function<ScriptableEntity*(Entity, Scene&)> m_instantiate_fun;
+    std::function<void(ScriptableEntity*)> m_destroy_fun;
   };
 
   //----------------------------------------------------------------------------------------------
@@ -205,6 +219,30 @@ namespace GE
     AmbientLightComponent,
     LightSourceComponent //
     >;
+
+  /**
+   * Bitmask with one bit set for each component type that an entity has
+   */
+  using ComponentSignature = u32;
+  static_assert(std::variant_size_v<VarComponent> <= sizeof(ComponentSignature) * 8,
+                "Too many components to fit in signature");
+
+  /**
+   * Compile-time identifier of a component type, given by its index in VarComponent
+   */
+  template <typename Component>
+  constexpr u32 ComponentID = []<typename... Comps>(std::type_identity<std::variant<Comps...>>)
+  {
+    u32 id = 0;
+    [[maybe_unused]] const bool found = (... || (std::is_same_v<Component, Comps> || (++id, false)));
+    return id;
+  }(std::type_identity<VarComponent>{});
+
+  /**
+   * Signature of an entity that has all the given components
+   */
+  template <typename... Comps>
+  constexpr ComponentSignature ComponentMask = (0u | ... | (1u << ComponentID<Comps>));
 }
 
 bool operator==(const GE::VarComponent& lhs, const GE::VarComponent& rhs);
@@ -1,67 +1,184 @@
 #include "scene/ge_ec_registry.hpp"
 
 #include "profiling/ge_profiler.hpp"
-#include "utils/ge_random.hpp"
 
 using namespace GE;
 
+namespace
+{
+  /**
+   * Largest amount of slots that a pushed handle can skip before it is remapped
+   */
+  constexpr u32 MAX_PUSH_GAP = 1024;
+}
+
+ECRegistry::ECRegistry(StorageMode mode) : m_mode(mode) {}
+
 Entity ECRegistry::Create()
 {
   GE_PROFILE;
-  auto id = Random::GenInt();
-  Entity e{ id };
-  auto [_, ok] = m_entities.insert(e);
-  GE_ASSERT(ok, "Random id collision");
-  m_entities_sorted_list.push_back(e);
-  return e;
+  if (m_free_slots.empty())
+    return Revive(AppendSlot());
+
+  const u32 slot = m_free_slots.back();
+  m_free_slots.pop_back();
+  return Revive(slot);
 }
 
-void ECRegistry::Push(Entity ent)
+std::vector<Entity> ECRegistry::CreateMany(u32 count, Opt<Entity> prefab)
 {
-  auto [it, inserted] = m_entities.insert(ent);
-  GE_ASSERT_OR_RETURN_VOID(inserted, "Entity already exists");
-  m_entities_sorted_list.push_back(ent);
+  GE_PROFILE;
+  GE_ASSERT_OR_RETURN(!prefab || IsValid(prefab.value()), {}, "Invalid prefab entity");
+
+  const auto first_slot = static_cast<u32>(m_slot_entities.size());
+  const u32 prefab_slot = prefab ? prefab->Index() : 0;
+  const ComponentSignature signature = prefab ? m_slot_signatures[prefab_slot] : 0;
+
+  m_slot_entities.reserve(first_slot + count);
+  m_slot_alive.reserve(first_slot + count);
+  m_slot_enabled.reserve(first_slot + count);
+  m_slot_dense_index.reserve(first_slot + count);
+  m_slot_signatures.reserve(first_slot + count);
+  m_entities.reserve(m_entities.size() + count);
+  m_entities_ordered.reserve(m_entities_ordered.size() + count);
+
+  std::vector<Entity> entities;
+  entities.reserve(count);
+  for (u32 i = 0; i < count; i++)
+  {
+    const Entity ent = Revive(AppendSlot());
+    m_slot_signatures[ent.Index()] = signature;
+    entities.push_back(ent);
+  }
+
+  if (prefab && m_mode == StorageMode::ARCHETYPE)
+  {
+    for (const Entity& ent : entities)
+      m_archetypes.Copy(ent.Index(), prefab_slot, m_version);
+  }
+  else if (prefab)
+  {
+    std::apply(
+      [&](auto&... pools)
+      {
+        (...,
+         [&]
+         {
+           if (!pools.Has(prefab_slot))
+             return;
+
+           // Copied before reserving, which invalidates references to the pool
+           const auto component = pools.Get(prefab_slot);
+           pools.Reserve(pools.Size() + count);
+           for (const Entity& ent : entities)
+             pools.Emplace(ent.Index(), m_version, component);
+         }());
+      },
+      m_pools);
+  }
+
+  for (EntityView& view : m_views)
+  {
+    if (!view.Matches(signature))
+      continue;
+
+    for (const Entity& ent : entities)
+      view.Insert(ent.Index(), ent);
+  }
+
+  return entities;
+}
+
+Entity ECRegistry::Push(Entity ent)
+{
+  GE_PROFILE;
+  const u32 slot = ent.Index();
+  const bool in_use = slot < m_slot_entities.size() && m_slot_alive[slot];
+  // A generation older than the one of the slot would make its stale handles valid again
+  const bool stale =
+    slot < m_slot_entities.size() && ent.Generation() < m_slot_entities[slot].Generation();
+  if (in_use || stale || slot > m_slot_entities.size() + MAX_PUSH_GAP)
+  {
+    GE_ASSERT_OR_RETURN(!in_use || m_slot_entities[slot] != ent, ent, "Entity already exists");
+
+    const Entity remapped = Create();
+    GE_INFO("Remapping entity id={} to id={}", ent.handle, remapped.handle)
+    return remapped;
+  }
+
+  if (slot < m_slot_entities.size())
+  {
+    // Older handles of this slot waiting to be compacted have older generations, so they stay
+    // invalid
+    std::erase(m_free_slots, slot);
+  }
+  else
+  {
+    // Slots skipped by the pushed handle become available for new entities
+    while (m_slot_entities.size() < slot)
+      m_free_slots.push_back(AppendSlot());
+    AppendSlot();
+  }
+
+  m_slot_entities[slot] = ent;
+  return Revive(slot);
 }
 
 void ECRegistry::OnEach(const std::function<void(Entity)>& action) const
 {
-  std::ranges::for_each(m_entities_sorted_list, action);
+  // Indexed loop since the action may create or destroy entities
+  m_iterating++;
+  for (u64 i = 0; i < m_entities_ordered.size(); i++)
+  {
+    const Entity ent = m_entities_ordered[i];
+    if (IsValid(ent))
+      action(ent);
+  }
+  m_iterating--;
 }
 
 void ECRegistry::DisableEntity(Entity ent)
 {
   GE_PROFILE;
-  if (!m_entities.contains(ent))
-    return;
-
-  if (m_entities_disabled.contains(ent))
+  if (!IsValid(ent) || !m_slot_enabled[ent.Index()])
     return;
 
-  m_entities_disabled.insert(m_entities.extract(ent));
+  m_slot_enabled[ent.Index()] = false;
+  if (m_mode == StorageMode::ARCHETYPE)
+    m_archetypes.SetEnabled(ent.Index(), false);
+  UpdateViews(ent.Index());
 }
 
 void ECRegistry::EnableEntity(Entity ent)
 {
   GE_PROFILE;
-  if (m_entities.contains(ent))
-    return;
-
-  if (!m_entities_disabled.contains(ent))
+  if (!IsValid(ent) || m_slot_enabled[ent.Index()])
     return;
 
-  m_entities.insert(m_entities_disabled.extract(ent));
+  m_slot_enabled[ent.Index()] = true;
+  if (m_mode == StorageMode::ARCHETYPE)
+    m_archetypes.SetEnabled(ent.Index(), true);
+  UpdateViews(ent.Index());
 }
 
 bool ECRegistry::operator==(const ECRegistry& other) const
 {
-  const bool entities_equal = m_entities == other.m_entities;
-  const bool components_equal = m_entities_with_components == other.m_entities_with_components;
-  return entities_equal && components_equal;
+  if (m_entities.size() != other.m_entities.size())
+    return false;
+
+  return std::ranges::all_of(m_entities,
+                             [&](Entity ent)
+                             {
+                               const u32 slot = ent.Index();
+                               return other.IsValid(ent) &&
+                                      m_slot_enabled[slot] == other.m_slot_enabled[slot] &&
+                                      m_slot_signatures[slot] == other.m_slot_signatures[slot];
+                             });
 }
 
 void ECRegistry::OnEach(const std::function<void(Entity)>& action)
 {
-  std::ranges::for_each(m_entities_sorted_list, action);
+  std::as_const(*this).OnEach(action);
 }
 
 void ECRegistry::Destroy(Opt<Entity> ent)
@@ -69,25 +186,121 @@ void ECRegistry::Destroy(Opt<Entity> ent)
   if (!ent)
     return;
 
-  m_entities.erase(ent.value());
-  std::erase(m_entities_sorted_list, ent.value());
-  m_components.erase(ent.value());
-  m_entities_with_components.erase(ent.value());
+  if (!IsValid(ent.value()))
+    return;
+
+  const u32 slot = ent->Index();
+  if (m_mode == StorageMode::ARCHETYPE)
+    m_archetypes.Erase(slot);
+  else
+    std::apply([&](auto&... pools) { (..., pools.Remove(slot)); }, m_pools);
+  m_slot_signatures[slot] = 0;
+  m_slot_alive[slot] = false;
+  UpdateViews(slot);
+
+  // Swap the last dense entity into the place of the destroyed one
+  const u32 dense_index = m_slot_dense_index[slot];
+  const Entity last = m_entities.back();
+  m_entities[dense_index] = last;
+  m_slot_dense_index[last.Index()] = dense_index;
+  m_entities.pop_back();
+
+  m_slot_entities[slot] = Entity::Make(slot, ent->Generation() + 1);
+  m_free_slots.push_back(slot);
+
+  // The ordered list keeps the stale handle until it is compacted
+  m_stale_ordered_count++;
+  if (m_iterating == 0 && m_stale_ordered_count * 2 > m_entities_ordered.size())
+    CompactOrder();
 }
 
-const std::vector<VarComponent>& ECRegistry::GetComponents(const Entity& ent) const
+const std::vector<Entity>& ECRegistry::GetEntities() const
 {
-  GE_ASSERT(m_components.contains(ent), "Entity not found!");
+  return m_entities;
+}
 
-  return m_components.at(ent);
+u32 ECRegistry::GetSlotsCount() const
+{
+  return static_cast<u32>(m_slot_entities.size());
 }
 
-const std::list<Entity>& ECRegistry::GetEntitiesList() const
+bool ECRegistry::IsValid(const Entity& ent) const
 {
-  return m_entities_sorted_list;
+  const u32 slot = ent.Index();
+  return slot < m_slot_entities.size() && m_slot_alive[slot] && m_slot_entities[slot] == ent;
 }
 
-const std::set<Entity>& ECRegistry::GetEntitiesSet() const
+u32 ECRegistry::GetSlot(const Entity& ent) const
 {
-  return m_entities;
+  GE_ASSERT(IsValid(ent), "Entity not found!");
+
+  return ent.Index();
+}
+
+u32 ECRegistry::AppendSlot()
+{
+  const auto slot = static_cast<u32>(m_slot_entities.size());
+  GE_ASSERT(slot <= Entity::INDEX_MASK, "Maximum number of entities reached");
+
+  m_slot_entities.push_back(Entity::Make(slot, 0));
+  m_slot_alive.push_back(false);
+  m_slot_enabled.push_back(false);
+  m_slot_dense_index.push_back(0);
+  m_slot_signatures.push_back(0);
+  return slot;
+}
+
+Entity ECRegistry::Revive(u32 slot)
+{
+  const Entity ent = m_slot_entities[slot];
+  m_slot_alive[slot] = true;
+  m_slot_enabled[slot] = true;
+  m_slot_signatures[slot] = 0;
+  m_slot_dense_index[slot] = static_cast<u32>(m_entities.size());
+  m_entities.push_back(ent);
+  m_entities_ordered.push_back(ent);
+  if (m_mode == StorageMode::ARCHETYPE)
+    m_archetypes.Insert(ent);
+  UpdateViews(slot);
+  return ent;
+}
+
+void ECRegistry::UpdateViews(u32 slot)
+{
+  const Entity ent = m_slot_entities[slot];
+  const bool enabled = m_slot_alive[slot] && m_slot_enabled[slot];
+  for (EntityView& view : m_views)
+  {
+    if (enabled && view.Matches(m_slot_signatures[slot]))
+      view.Insert(slot, ent);
+    else
+      view.Erase(slot);
+  }
+}
+
+const EntityView& ECRegistry::GetView(ComponentSignature mask) const
+{
+  auto found = std::ranges::find(m_views, mask, &EntityView::GetMask);
+  if (found != m_views.end())
+    return *found;
+
+  GE_PROFILE;
+  EntityView& view = m_views.emplace_back(mask);
+  for (const Entity& ent : m_entities)
+  {
+    const u32 slot = ent.Index();
+    if (m_slot_enabled[slot] && view.Matches(m_slot_signatures[slot]))
+      view.Insert(slot, ent);
+  }
+  return view;
+}
+
+void ECRegistry::CompactOrder()
+{
+  if (m_stale_ordered_count == 0)
+    return;
+
+  GE_PROFILE;
+  std::erase_if(m_entities_ordered, [this](Entity ent) { return !IsValid(ent); });
+  m_stale_ordered_count = 0;
 }
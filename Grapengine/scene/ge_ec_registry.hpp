@@ -1,22 +1,57 @@
 #ifndef GRAPENGINE_GE_EC_REGISTRY_HPP
 #define GRAPENGINE_GE_EC_REGISTRY_HPP
 
+#include "core/ge_thread_pool.hpp"
+#include "ge_archetype_storage.hpp"
+#include "ge_component_pool.hpp"
 #include "ge_components.hpp"
 #include "ge_entity.hpp"
+#include "ge_entity_view.hpp"
 #include "profiling/ge_profiler.hpp"
 
 namespace GE
 {
+  /**
+   * How the registry stores components: one sparse set for each component type, or entities
+   * with the same signature packed together in chunks of parallel arrays
+   */
+  enum class StorageMode : u8
+  {
+    SPARSE_SET,
+    ARCHETYPE
+  };
+
   class ECRegistry
   {
   public:
+    static constexpr u64 DEFAULT_GRAIN = 256;
+
+    explicit ECRegistry(StorageMode mode = StorageMode::SPARSE_SET);
+
+    [[nodiscard]] StorageMode GetStorageMode() const { return m_mode; }
+
     /**
      * Create and return an entity with a unique id
      * @return empty entity
      */
     Entity Create();
 
-    void Push(Entity ent);
+    /**
+     * Create many entities at once, with contiguous handles and storage reserved only once
+     * @param count number of entities to be created
+     * @param prefab entity whose components are copied to every created entity
+     * @return created entities
+     */
+    std::vector<Entity> CreateMany(u32 count, Opt<Entity> prefab = std::nullopt);
+
+    /**
+     * Insert an entity with a known handle, such as a deserialized one
+     * Handles that cannot be honored (slot in use or far beyond the current slots, like the
+     * random ids of older scene files) are remapped to a newly created entity
+     * @param ent entity to insert
+     * @return inserted entity, which is the remapped one when the handle was not honored
+     */
+    Entity Push(Entity ent);
 
     void Destroy(Opt<Entity> ent);
 
@@ -26,17 +61,20 @@ namespace GE
      * @tparam Args argument list to construct the component
      * @param ent entity that is associated of component
      * @param args argument list to construct the component
+     * @return added component
      */
     template <typename Component, typename... Args>
-    void AddComponent(const Entity& ent, Args... args)
+    Component& AddComponent(const Entity& ent, Args&&... args)
     {
       GE_PROFILE;
       GE_ASSERT(!Has<Component>(ent), "Entity already has this component!");
 
-      /*VarComponent& added =*/
-      m_components[ent].emplace_back(std::in_place_type<Component>, std::forward<Args>(args)...);
-      m_entities_with_components[ent].insert(typeid(Component).hash_code());
-
+      const u32 slot = GetSlot(ent);
+      m_slot_signatures[slot] |= ComponentMask<Component>;
+      UpdateViews(slot);
+      if (m_mode == StorageMode::ARCHETYPE)
+        return m_archetypes.Emplace<Component>(slot, m_version, std::forward<Args>(args)...);
+      return Pool<Component>().Emplace(slot, m_version, std::forward<Args>(args)...);
     }
 
     template <typename Component>
@@ -45,21 +83,30 @@ namespace GE
       GE_PROFILE;
       GE_ASSERT(!Has<Component>(ent), "Entity already has this component!");
 
-      m_components[ent].emplace_back(component);
-      m_entities_with_components[ent].insert(typeid(Component).hash_code());
+      const u32 slot = GetSlot(ent);
+      m_slot_signatures[slot] |= ComponentMask<Component>;
+      UpdateViews(slot);
+      if (m_mode == StorageMode::ARCHETYPE)
+        m_archetypes.Emplace<Component>(slot, m_version, std::forward<Component>(component));
+      else
+        Pool<Component>().Emplace(slot, m_version, std::forward<Component>(component));
     }
 
     template <typename Component>
     void RemoveComponent(Entity entity)
     {
-      m_entities_with_components[entity].erase(typeid(Component).hash_code());
-      auto& ent_components = m_components[entity];
-      std::erase_if(ent_components,
-                    [&](const VarComponent& c) { return std::holds_alternative<Component>(c); });
+      const u32 slot = GetSlot(entity);
+      m_slot_signatures[slot] &= ~ComponentMask<Component>;
+      UpdateViews(slot);
+      if (m_mode == StorageMode::ARCHETYPE)
+        m_archetypes.Remove<Component>(slot);
+      else
+        Pool<Component>().Remove(slot);
     }
 
     /**
      * Retrieve the component of type Comp associated with entity
+     * The component is marked as changed at the current version
      * @tparam Component component type to be got
      * @param ent entity that is associated with component
      * @return associated component
@@ -70,12 +117,26 @@ namespace GE
       GE_PROFILE;
       GE_ASSERT(Has<Component>(ent), "Entity does not have this component!");
 
-      auto found = std::ranges::find_if(m_components.at(ent),
-                                        [&](auto&& anyComp)
-                                        { return std::holds_alternative<Component>(anyComp); });
-      VarComponent& var_component = *found;
-      Component* alc = std::get_if<Component>(&var_component);
-      return *alc;
+      const u32 slot = GetSlot(ent);
+      if (m_mode == StorageMode::ARCHETYPE)
+      {
+        m_archetypes.Touch<Component>(slot, m_version);
+        return m_archetypes.Get<Component>(slot);
+      }
+      Pool<Component>().Touch(slot, m_version);
+      return Pool<Component>().Get(slot);
+    }
+
+    /**
+     * Change the component of type Comp associated with entity and mark it as changed
+     * @tparam Component component type to be changed
+     * @param ent entity that is associated with component
+     * @param fun function called with the component to be changed
+     */
+    template <typename Component, typename Fun>
+    void Patch(const Entity& ent, Fun&& fun)
+    {
+      fun(GetComponent<Component>(ent));
     }
 
     /**
@@ -90,18 +151,84 @@ namespace GE
       GE_PROFILE;
       GE_ASSERT(Has<Component>(ent), "Entity does not have this component!");
 
-      auto found = std::ranges::find_if(m_components.at(ent),
-                                        [&](auto&& anyComp)
-                                        { return std::holds_alternative<Component>(anyComp); });
-      const VarComponent& var_component = *found;
-      const Component* alc = std::get_if<Component>(&var_component);
-      return *alc;
+      if (m_mode == StorageMode::ARCHETYPE)
+        return m_archetypes.Get<Component>(GetSlot(ent));
+      return Pool<Component>().Get(GetSlot(ent));
     }
 
-    [[nodiscard]] const std::vector<VarComponent>& GetComponents(const Entity& ent) const;
+    /**
+     * Current change version, that stamps every component changed from now on
+     */
+    [[nodiscard]] u64 GetVersion() const { return m_version; }
 
-    [[nodiscard]] const std::list<Entity>& GetEntitiesList() const;
-    [[nodiscard]] const std::set<Entity>& GetEntitiesSet() const;
+    /**
+     * Start a new change version, so changes before it can be told apart, as in a new frame
+     */
+    void AdvanceVersion() { m_version++; }
+
+    /**
+     * Retrieve the version of the last change of the component associated with entity
+     * @tparam Component component type to be verified
+     * @param ent entity associated
+     * @return version when the component was added or last changed
+     */
+    template <typename Component>
+    [[nodiscard]] u64 GetComponentVersion(const Entity& ent) const
+    {
+      if (m_mode == StorageMode::ARCHETYPE)
+        return m_archetypes.GetVersion<Component>(GetSlot(ent));
+      return Pool<Component>().GetVersion(GetSlot(ent));
+    }
+
+    /**
+     * Retrieve the entities that has all passed components where any of them changed after a
+     * version
+     * @tparam Comps list of components used to query the entities
+     * @param version version to compare with
+     * @return entities with changed components
+     */
+    template <typename... Comps>
+    [[nodiscard]] std::vector<Entity> Changed(u64 version) const
+    {
+      GE_PROFILE;
+      std::vector<Entity> entities;
+      for (const Entity& ent : Group<Comps...>())
+      {
+        if ((... || (GetComponentVersion<Comps>(ent) > version)))
+          entities.push_back(ent);
+      }
+      return entities;
+    }
+
+    /**
+     * Call the visitor with each component associated with entity
+     * @param ent entity whose components are visited
+     * @param visitor callable with an overload for each component type
+     */
+    template <typename Visitor>
+    void VisitComponents(const Entity& ent, Visitor&& visitor) const
+    {
+      GE_PROFILE;
+      const u32 slot = GetSlot(ent);
+      if (m_mode == StorageMode::ARCHETYPE)
+      {
+        m_archetypes.Visit(slot, std::forward<Visitor>(visitor));
+        return;
+      }
+
+      std::apply(
+        [&](const auto&... pools)
+        {
+          (..., [&] { if (pools.Has(slot)) visitor(pools.Get(slot)); }());
+        },
+        m_pools);
+    }
+
+    /**
+     * Alive entities, including disabled ones, in no particular order
+     */
+    [[nodiscard]] const std::vector<Entity>& GetEntities() const;
+    [[nodiscard]] u32 GetSlotsCount() const;
 
     /**
      * Verify if associated component exist with given entity
@@ -113,62 +240,161 @@ namespace GE
     [[nodiscard]] bool Has(const Entity& ent) const
     {
       GE_PROFILE;
-      if (!m_entities.contains(ent))
-        return false;
-
-      if (!m_components.contains(ent))
+      if (!IsValid(ent) || !m_slot_enabled[ent.Index()])
         return false;
 
-      if (m_components.at(ent).empty())
-        return false;
-
-      auto found = std::ranges::find_if(m_entities_with_components.at(ent),
-                                        [&](u64 compHashCode)
-                                        { return typeid(Comp).hash_code() == compHashCode; });
-      return found != m_entities_with_components.at(ent).end();
+      constexpr ComponentSignature mask = ComponentMask<Comp>;
+      return (m_slot_signatures[ent.Index()] & mask) == mask;
     }
 
     /**
      * Retrieve list of entities that has all passed components
+     * The list is a persistent view kept up to date by the registry, so it should not be held
+     * across structural changes (create, destroy, add or remove components)
      * @tparam Comps list of components used to query the entities
-     * @return set of entities that has all given components in common
+     * @return entities that has all given components in common
      */
     template <typename... Comps>
-    [[nodiscard]] std::vector<Entity> Group() const
+    [[nodiscard]] const std::vector<Entity>& Group() const
     {
       GE_PROFILE;
+      return GetView(ComponentMask<Comps...>).GetEntities();
+    }
 
-      // Get all component types id required
-      std::set<u64> comps;
-      (..., [&] { comps.insert(typeid(Comps).hash_code()); }());
-
-      std::vector<Entity> entities;
-      for (const auto& [ent, its_comps] : m_entities_with_components)
+    /**
+     * Call the function with each entity that has all passed components, splitting the entities
+     * in chunks that run in parallel on the engine thread pool.
+     * The function must not change the registry structure, and only the components of the
+     * given entity should be changed. The components are marked as changed.
+     * @tparam Comps list of components used to query the entities
+     * @param fun function called as fun(Entity, Comps&...)
+     * @param grain maximum number of entities handled by each chunk. In archetype storage mode,
+     * storage chunks are not split, so it is the average number of entities of each task
+     */
+    template <typename... Comps, typename Fun>
+    void ParallelEach(Fun&& fun, u64 grain = DEFAULT_GRAIN)
+    {
+      GE_PROFILE;
+      if (m_mode == StorageMode::ARCHETYPE)
       {
-        if (m_entities_disabled.contains(ent))
-          continue;
-
-        if (std::ranges::includes(its_comps, comps))
-          entities.push_back(ent);
+        // Each chunk is already a packed range, so chunks are the unit of work, as many as the
+        // grain holds on average
+        const auto chunks = m_archetypes.GetChunks(ComponentMask<Comps...>);
+        u64 rows = 0;
+        for (const auto& chunk : chunks)
+          rows += m_archetypes.Count(chunk);
+        const u64 chunks_grain = std::max<u64>(grain * chunks.size() / std::max<u64>(rows, 1), 1);
+        auto each_row = [&](u32 count, const Entity* entities, Comps*... components)
+        {
+          for (u32 i = 0; i < count; i++)
+            fun(entities[i], components[i]...);
+        };
+        ThreadPool::Get().ParallelFor(chunks.size(),
+                                      chunks_grain,
+                                      [&](u64 begin, u64 end)
+                                      {
+                                        for (u64 i = begin; i < end; i++)
+                                          VisitChunk<Comps...>(chunks[i], each_row);
+                                      });
+        return;
       }
-      return entities;
+
+      const std::vector<Entity>& entities = Group<Comps...>();
+      ThreadPool::Get().ParallelFor(entities.size(),
+                                    grain,
+                                    [&](u64 begin, u64 end)
+                                    {
+                                      for (u64 i = begin; i < end; i++)
+                                      {
+                                        const Entity ent = entities[i];
+                                        (..., Pool<Comps>().Touch(ent.Index(), m_version));
+                                        fun(ent, Pool<Comps>().Get(ent.Index())...);
+                                      }
+                                    });
+    }
+
+    /**
+     * Call the function with each chunk of enabled entities that has all passed components.
+     * Available only in archetype storage mode, where the components of a chunk are packed in
+     * parallel arrays. The components are marked as changed.
+     * @tparam Comps list of components used to query the chunks
+     * @param fun function called as fun(u32 count, const Entity* entities, Comps*... components)
+     */
+    template <typename... Comps, typename Fun>
+    void EachChunk(Fun&& fun)
+    {
+      GE_PROFILE;
+      GE_ASSERT_OR_RETURN_VOID(m_mode == StorageMode::ARCHETYPE,
+                               "Chunks are available only in archetype storage mode");
+
+      const auto chunks = m_archetypes.GetChunks(ComponentMask<Comps...>);
+      for (const ArchetypeStorage::ChunkRef& chunk : chunks)
+        VisitChunk<Comps...>(chunk, fun);
     }
 
+    /**
+     * Call the action with each alive entity, in the order they were created
+     */
     void OnEach(const std::function<void(Entity)>& action);
     void OnEach(const std::function<void(Entity)>& action) const;
 
+    /**
+     * Verify if the entity is alive, that is, its handle is not stale
+     * @param ent entity to be verified
+     * @return true if the entity was not destroyed
+     */
+    [[nodiscard]] bool IsValid(const Entity& ent) const;
+
     void DisableEntity(Entity ent);
     void EnableEntity(Entity ent);
 
     [[nodiscard]] bool operator==(const ECRegistry& other) const;
 
   private:
-    std::set<Entity> m_entities;
-    std::set<Entity> m_entities_disabled;
-    std::list<Entity> m_entities_sorted_list;
-    std::map<Entity, std::vector<VarComponent>> m_components;
-    std::map<Entity, std::set<u64>> m_entities_with_components;
-    std::set<Entity> m_destroy_queue;
+    using Pools = ComponentPoolsOf<VarComponent>::Type;
+
+    template <typename Component>
+    [[nodiscard]] ComponentPool<Component>& Pool()
+    {
+      return std::get<ComponentPool<Component>>(m_pools);
+    }
+
+    template <typename Component>
+    [[nodiscard]] const ComponentPool<Component>& Pool() const
+    {
+      return std::get<ComponentPool<Component>>(m_pools);
+    }
+
+    template <typename... Comps, typename Fun>
+    void VisitChunk(const ArchetypeStorage::ChunkRef& chunk, Fun& fun)
+    {
+      const u32 count = m_archetypes.Count(chunk);
+      (..., std::fill_n(m_archetypes.Versions<Comps>(chunk), count, m_version));
+      fun(count, m_archetypes.Entities(chunk), m_archetypes.Components<Comps>(chunk)...);
+    }
+
+    [[nodiscard]] u32 GetSlot(const Entity& ent) const;
+    u32 AppendSlot();
+    Entity Revive(u32 slot);
+    void UpdateViews(u32 slot);
+    void CompactOrder();
+    [[nodiscard]] const EntityView& GetView(ComponentSignature mask) const;
+
+    std::vector<Entity> m_entities;
+    std::vector<Entity> m_entities_ordered;
+    u64 m_stale_ordered_count = 0;
+    mutable u32 m_iterating = 0;
+    std::vector<Entity> m_slot_entities;
+    std::vector<bool> m_slot_alive;
+    std::vector<bool> m_slot_enabled;
+    std::vector<u32> m_slot_dense_index;
+    std::vector<ComponentSignature> m_slot_signatures;
+    std::vector<u32> m_free_slots;
+    StorageMode m_mode;
+    Pools m_pools;
+    ArchetypeStorage m_archetypes;
+    u64 m_version = 1;
+    mutable std::deque<EntityView> m_views;
   };
 } // GE
 
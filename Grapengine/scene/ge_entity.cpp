@@ -3,3 +3,8 @@
 using namespace GE;
 
 Entity::Entity(u32 h) : handle(h) {}
+
+Entity Entity::Make(u32 index, u32 generation)
+{
+  return Entity{ ((generation & GENERATION_MASK) << INDEX_BITS) | (index & INDEX_MASK) };
+}
@@ -5,11 +5,24 @@
 
 namespace GE
 {
+  /**
+   * Entity handle made of a slot index in the low bits and the slot generation in the high bits.
+   * The generation changes every time the slot is reused, so stale handles can be detected.
+   */
   struct Entity
   {
+    static constexpr u32 INDEX_BITS = 20;
+    static constexpr u32 INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr u32 GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+
     u32 handle;
 
     explicit Entity(u32 h);
+    static Entity Make(u32 index, u32 generation);
+
+    [[nodiscard]] u32 Index() const { return handle & INDEX_MASK; }
+    [[nodiscard]] u32 Generation() const { return handle >> INDEX_BITS; }
+
     bool operator<(const Entity& ent) const { return handle < ent.handle; }
 
     bool operator==(const Entity& rhs) const { return handle == rhs.handle; }
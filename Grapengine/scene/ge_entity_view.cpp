@@ -0,0 +1,46 @@
+#include "scene/ge_entity_view.hpp"
+
+using namespace GE;
+
+namespace
+{
+  constexpr u32 INVALID_POSITION = std::numeric_limits<u32>::max();
+}
+
+EntityView::EntityView(ComponentSignature mask) : m_mask(mask) {}
+
+bool EntityView::Contains(u32 slot) const
+{
+  return slot < m_slots_positions.size() && m_slots_positions[slot] != INVALID_POSITION;
+}
+
+void EntityView::Insert(u32 slot, Entity ent)
+{
+  if (Contains(slot))
+    return;
+
+  if (slot >= m_slots_positions.size())
+    m_slots_positions.resize(slot + 1, INVALID_POSITION);
+
+  m_slots_positions[slot] = static_cast<u32>(m_entities.size());
+  m_entities.push_back(ent);
+  m_entities_slots.push_back(slot);
+}
+
+void EntityView::Erase(u32 slot)
+{
+  if (!Contains(slot))
+    return;
+
+  const u32 pos = m_slots_positions[slot];
+  const u32 last_pos = static_cast<u32>(m_entities.size() - 1);
+  if (pos != last_pos)
+  {
+    m_entities[pos] = m_entities[last_pos];
+    m_entities_slots[pos] = m_entities_slots[last_pos];
+    m_slots_positions[m_entities_slots[pos]] = pos;
+  }
+  m_entities.pop_back();
+  m_entities_slots.pop_back();
+  m_slots_positions[slot] = INVALID_POSITION;
+}
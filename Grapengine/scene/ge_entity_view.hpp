@@ -0,0 +1,39 @@
+#ifndef GRAPENGINE_GE_ENTITY_VIEW_HPP
+#define GRAPENGINE_GE_ENTITY_VIEW_HPP
+
+#include "ge_components.hpp"
+#include "ge_entity.hpp"
+
+namespace GE
+{
+  /**
+   * Persistent list of the enabled entities whose signature contains a given component mask.
+   * The registry keeps it up to date on every structural change, so querying it is free.
+   */
+  class EntityView
+  {
+  public:
+    explicit EntityView(ComponentSignature mask);
+
+    [[nodiscard]] ComponentSignature GetMask() const { return m_mask; }
+    [[nodiscard]] bool Matches(ComponentSignature signature) const
+    {
+      return (signature & m_mask) == m_mask;
+    }
+
+    [[nodiscard]] bool Contains(u32 slot) const;
+
+    void Insert(u32 slot, Entity ent);
+    void Erase(u32 slot);
+
+    [[nodiscard]] const std::vector<Entity>& GetEntities() const { return m_entities; }
+
+  private:
+    ComponentSignature m_mask;
+    std::vector<Entity> m_entities;
+    std::vector<u32> m_entities_slots;
+    std::vector<u32> m_slots_positions;
+  };
+}
+
+#endif // GRAPENGINE_GE_ENTITY_VIEW_HPP
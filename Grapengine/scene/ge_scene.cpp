@@ -1,28 +1,29 @@
 #include "ge_scene.hpp"
 
+#include "core/ge_thread_pool.hpp"
 #include "events/ge_event.hpp"
 #include "math/ge_vector.hpp"
 #include "profiling/ge_profiler.hpp"
+#include "renderer/ge_batch_builder.hpp"
 #include "renderer/ge_editor_camera.hpp"
 #include "renderer/ge_renderer.hpp"
 #include "scene/ge_components.hpp"
 #include "scene/ge_scriptable_entity.hpp"
-#include "utils/ge_random.hpp"
 
 using namespace GE;
 
-namespace
+Scene::Scene(const std::string& name, StorageMode storageMode) :
+    m_name(name),
+    m_registry(storageMode),
+    m_active_camera(std::nullopt),
+    m_textures_registry()
 {
-  std::deque<Entity>& GetQueue()
-  {
-    static std::deque<Entity> m_destroy_queue{};
-    return m_destroy_queue;
-  };
 }
 
-Scene::Scene(const std::string& name) :
-    m_name(name), m_registry({}), m_active_camera(std::nullopt), m_textures_registry()
+Scene::~Scene()
 {
+  m_frame++;
+  ReleaseUndrawnMeshes();
 }
 
 void Scene::OnUpdate(TimeStep ts)
@@ -32,7 +33,8 @@ void Scene::OnUpdate(TimeStep ts)
   UpdateActiveCamera();
 
   const auto& active_camera = m_active_camera.value();
-  const auto& cam = m_registry.GetComponent<CameraComponent>(active_camera).GetCamera();
+  const auto& cam =
+    std::as_const(m_registry).GetComponent<CameraComponent>(active_camera).GetCamera();
   const auto& cam_matrix = cam.GetViewProjection();
   const auto& cam_pos = cam.GetPosition();
   UpdateWithCamera(ts, cam_matrix, cam_pos);
@@ -51,41 +53,53 @@ void Scene::OnUpdateEditor(TimeStep ts, EditorCamera& editorCamera)
 
 void Scene::UpdateLightSources() const
 {
-  auto light_sources = m_registry.Group<LightSourceComponent>();
+  // Lights are set even when there are none, and they are only uploaded when they change
+  const auto& light_sources = m_registry.Group<LightSourceComponent>();
+  std::vector<LightSource> props;
   if (!light_sources.empty())
   {
-    std::vector<LightSource> props;
-    props.reserve(light_sources.size());
+    // Lights are read in parallel into their own places, and the active ones keep their order
+    std::vector<Opt<LightSource>> gathered(light_sources.size());
+    ThreadPool::Get().ParallelFor(
+      light_sources.size(),
+      ECRegistry::DEFAULT_GRAIN,
+      [&](u64 begin, u64 end)
+      {
+        for (u64 i = begin; i < end; i++)
+        {
+          const auto& lp = m_registry.GetComponent<LightSourceComponent>(light_sources[i]);
+          if (lp.IsActive())
+            gathered[i] = lp.GetLightSource();
+        }
+      });
 
-    auto is_active = [&](auto&& ls)
-    { return m_registry.GetComponent<LightSourceComponent>(ls).IsActive(); };
-
-    std::ranges::transform(light_sources | std::views::filter(is_active),
-                           std::back_inserter(props),
-                           [&](Entity l) -> LightSource
-                           {
-                             const auto& lp = m_registry.GetComponent<LightSourceComponent>(l);
-                             return lp.GetLightSource();
-                           });
-    Renderer::SetLightSources(props);
+    props.reserve(light_sources.size());
+    for (const Opt<LightSource>& light_source : gathered)
+    {
+      if (light_source)
+        props.push_back(light_source.value());
+    }
   }
+  Renderer::SetLightSources(props);
 }
 
 void Scene::UpdateAmbientLight() const
 {
-  auto amb_lights = m_registry.Group<AmbientLightComponent>();
-  if (!amb_lights.empty())
-  {
-    auto amb_light_itr = std::ranges::find_if(
-      amb_lights,
-      [&](Entity al) { return m_registry.GetComponent<AmbientLightComponent>(al).IsActive(); });
+  // Scenes without an active ambient light have none, instead of the one of a previous frame
+  const auto& amb_lights = m_registry.Group<AmbientLightComponent>();
+  auto amb_light_itr = std::ranges::find_if(
+    amb_lights,
+    [&](Entity al) { return m_registry.GetComponent<AmbientLightComponent>(al).IsActive(); });
 
-    if (amb_light_itr != amb_lights.end())
-    {
-      const AmbientLightComponent& amb_light =
-        m_registry.GetComponent<AmbientLightComponent>(*amb_light_itr);
-      Renderer::SetAmbientLight(amb_light.GetColor(), amb_light.GetStr());
-    }
+  if (amb_light_itr != amb_lights.end())
+  {
+    const AmbientLightComponent& amb_light =
+      m_registry.GetComponent<AmbientLightComponent>(*amb_light_itr);
+    Renderer::SetAmbientLight(amb_light.GetColor(), amb_light.GetStr());
+  }
+  else
+  {
+    Renderer::SetAmbientLight(Colors::BLACK, 0.0f);
   }
 }
 
@@ -100,12 +114,13 @@ void Scene::UpdateActiveCamera()
 void Scene::UpdateNativeScripts(TimeStep& ts)
 {
   GE_PROFILE;
+  // Copied since scripts are free to change the registry structure while they run
   const std::vector<Entity> g = m_registry.Group<NativeScriptComponent>();
 
   // Move to Scene::OnScenePlay
   for (auto ent : g)
   {
-    const auto& nsc = m_registry.GetComponent<NativeScriptComponent>(ent);
+    auto& nsc = m_registry.GetComponent<NativeScriptComponent>(ent);
     if (!nsc.IsValid())
     {
       nsc.Instantiate(ent, *this);
@@ -127,40 +142,114 @@ void Scene::UpdateDrawableEntities(TimeStep& /*ts*/,
     return;
   }
 
+  const ECRegistry& registry = m_registry;
+  if (m_textures_registry.Update())
+    Renderer::SetTextureLayers(m_textures_registry.GetTextureLayers());
+  m_textures_registry.BindTextures();
+
+  const std::vector<Entity>& gmat = registry.Group<TransformComponent, PrimitiveComponent>();
   {
-    const std::vector<Entity> primitives = m_registry.Group<PrimitiveComponent>();
-    std::set<i32> textures_slots{ Texture2D::EMPTY_TEX_SLOT };
-    for (const auto& ent : primitives)
+    GE_PROFILE_SECTION("Transform update");
+    // Only transforms changed since their matrix was cached are evaluated again
+    m_model_matrices.resize(std::max<u64>(m_model_matrices.size(), registry.GetSlotsCount()));
+    ThreadPool::Get().ParallelFor(
+      gmat.size(),
+      ECRegistry::DEFAULT_GRAIN,
+      [&](u64 begin, u64 end)
+      {
+        for (u64 i = begin; i < end; i++)
+        {
+          const Entity ent = gmat[i];
+          const u64 version = registry.GetComponentVersion<TransformComponent>(ent);
+          ModelMatrixCache& cache = m_model_matrices[ent.Index()];
+          if (cache.entity_handle == ent.handle && cache.version == version)
+            continue;
+
+          cache.entity_handle = ent.handle;
+          cache.version = version;
+          cache.model = registry.GetComponent<TransformComponent>(ent).GetModelMat();
+        }
+      });
+    m_registry.AdvanceVersion();
+  }
+
+  // Opaque primitives are instances of meshes uploaded once, while translucent ones are batched
+  // to be sorted back to front
+  std::vector<Entity> translucent;
+  {
+    GE_PROFILE_SECTION("Instanced renderer");
+    m_meshes.resize(std::max<u64>(m_meshes.size(), registry.GetSlotsCount()));
+    m_frame++;
+    Renderer::Instancing::Begin(cameraMatrix, viewPosition);
+    for (auto ent : gmat)
     {
-      PrimitiveComponent& primitive = m_registry.GetComponent<PrimitiveComponent>(ent);
-      m_textures_registry.BindTexture(primitive.GetTexSlot());
-      textures_slots.insert(static_cast<i32>(primitive.GetTexSlot()));
+      const PrimitiveComponent& primitive = registry.GetComponent<PrimitiveComponent>(ent);
+      if (primitive.GetColor().A() < MAX_U8)
+      {
+        translucent.push_back(ent);
+        continue;
+      }
+
+      // The geometry is looked up again only when the primitive has changed. The new mesh is
+      // acquired before the old one is released, so an unchanged geometry stays uploaded
+      const u64 version = registry.GetComponentVersion<PrimitiveComponent>(ent);
+      MeshCache& cache = m_meshes[ent.Index()];
+      if (cache.entity_handle != ent.handle || cache.version != version)
+      {
+        const u32 mesh = Renderer::Instancing::AcquireMesh(primitive.GetDrawable());
+        if (cache.entity_handle != MeshCache{}.entity_handle)
+          Renderer::Instancing::ReleaseMesh(cache.mesh);
+        else
+          m_meshes_in_use.push_back(ent.Index());
+        cache.entity_handle = ent.handle;
+        cache.version = version;
+        cache.mesh = mesh;
+      }
+      cache.frame = m_frame;
+
+      Renderer::Instancing::PushInstance(cache.mesh,
+                                         m_model_matrices[ent.Index()].model,
+                                         primitive.GetColor(),
+                                         primitive.GetTexSlot());
     }
-    std::vector<i32> textures{ textures_slots.begin(), textures_slots.end() };
-    Renderer::SetTextureSlots(textures);
+    Renderer::Instancing::End();
+    ReleaseUndrawnMeshes();
   }
 
-  const std::vector<Entity> gmat = m_registry.Group<TransformComponent, PrimitiveComponent>();
   {
     GE_PROFILE_SECTION("Batch renderer");
-    Renderer::Batch::Begin(cameraMatrix, viewPosition);
-    for (auto ent : gmat)
+    // Drawables are read in place, since the registry does not change until the batch ends
+    std::vector<BatchDraw> draws;
+    draws.reserve(translucent.size());
+    for (auto ent : translucent)
     {
-      const TransformComponent& transl_scale_comp =
-        m_registry.GetComponent<TransformComponent>(ent);
-
-      PrimitiveComponent& primitive = m_registry.GetComponent<PrimitiveComponent>(ent);
-      primitive.GetDrawable().UpdateColor(primitive.GetColor());
-      primitive.GetDrawable().UpdateTexture(primitive.GetTexSlot());
-      VerticesData vertices = primitive.GetDrawable().GetVerticesData();
-      std::vector<u32> indices = primitive.GetDrawable().GetIndicesData();
-
-      Renderer::Batch::PushObject(std::move(vertices), indices, transl_scale_comp.GetModelMat());
+      const Drawable& drawable = registry.GetComponent<PrimitiveComponent>(ent).GetDrawable();
+      draws.push_back({ drawable.GetVerticesData().GetData(),
+                        drawable.GetIndicesData(),
+                        m_model_matrices[ent.Index()].model,
+                        true });
     }
+    Renderer::Batch::Begin(cameraMatrix, viewPosition);
+    Renderer::Batch::PushObjects(draws);
     Renderer::Batch::End();
   }
 }
 
+void Scene::ReleaseUndrawnMeshes()
+{
+  std::erase_if(m_meshes_in_use,
+                [&](u32 slot)
+                {
+                  MeshCache& cache = m_meshes[slot];
+                  if (cache.frame == m_frame)
+                    return false;
+
+                  Renderer::Instancing::ReleaseMesh(cache.mesh);
+                  cache = MeshCache{};
+                  return true;
+                });
+}
+
 void Scene::UpdateWithCamera(TimeStep& ts, const Mat4& cameraMatrix, const Vec3& viewPosition)
 {
   UpdateLightSourcesPosition(ts, cameraMatrix, viewPosition);
@@ -169,7 +258,7 @@ void Scene::UpdateWithCamera(TimeStep& ts, const Mat4& cameraMatrix, const Vec3&
 
   UpdateDrawableEntities(ts, cameraMatrix, viewPosition);
 
-  DestroyFromQueue();
+  FlushCommands();
 }
 
 Entity Scene::CreateEntity(std::string&& name)
@@ -180,16 +269,22 @@ Entity Scene::CreateEntity(std::string&& name)
   return ent;
 }
 
-void Scene::PushEntity(Entity entity)
+std::vector<Entity> Scene::CreateEntities(u32 count, Entity prefab)
+{
+  GE_PROFILE;
+  return m_registry.CreateMany(count, prefab);
+}
+
+Entity Scene::PushEntity(Entity entity)
 {
   GE_PROFILE;
-  m_registry.Push(entity);
   GE_INFO("Pushing entity with id={}", entity.handle)
+  return m_registry.Push(entity);
 }
 
-Ptr<Scene> Scene::Make(const std::string& name)
+Ptr<Scene> Scene::Make(const std::string& name, StorageMode storageMode)
 {
-  return MakeRef<Scene>(name);
+  return MakeRef<Scene>(name, storageMode);
 }
 
 void Scene::OnEvent(Event& /*ev*/)
@@ -202,7 +297,7 @@ void Scene::OnEvent(Event& /*ev*/)
 
 void Scene::OnViewportResize(Dimensions dim)
 {
-  const std::vector<Entity> camera_entities = m_registry.Group<CameraComponent>();
+  const std::vector<Entity>& camera_entities = m_registry.Group<CameraComponent>();
   for (auto ent : camera_entities)
   {
     auto& cam_comp = m_registry.GetComponent<CameraComponent>(ent);
@@ -216,7 +311,7 @@ void Scene::OnViewportResize(Dimensions dim)
 Opt<Entity> Scene::RetrieveActiveCamera() const
 {
   GE_PROFILE;
-  std::vector<Entity> camera_group = m_registry.Group<CameraComponent>();
+  const std::vector<Entity>& camera_group = m_registry.Group<CameraComponent>();
   if (camera_group.empty())
   {
     GE_INFO("No camera")
@@ -251,10 +346,10 @@ Opt<Entity> Scene::RetrieveActiveCamera() const
   return active_camera;
 }
 
-void Scene::DestroyFromQueue()
+void Scene::FlushCommands()
 {
-  for (auto ent : GetQueue())
-    m_registry.Destroy(ent);
+  GE_PROFILE;
+  m_commands.Playback(m_registry);
 }
 
 void Scene::OnEachEntity(const std::function<void(Entity)>& fun)
@@ -262,22 +357,12 @@ void Scene::OnEachEntity(const std::function<void(Entity)>& fun)
   GE_PROFILE;
   m_registry.OnEach(fun);
 
-  DestroyFromQueue();
-}
-
-const std::list<Entity>& Scene::GetEntitiesList() const
-{
-  return m_registry.GetEntitiesList();
-}
-
-const std::set<Entity>& Scene::GetEntitiesSet() const
-{
-  return m_registry.GetEntitiesSet();
+  FlushCommands();
 }
 
-const std::vector<VarComponent>& Scene::GetComponents(const Entity& ent) const
+const std::vector<Entity>& Scene::GetEntities() const
 {
-  return m_registry.GetComponents(ent);
+  return m_registry.GetEntities();
 }
 
 const std::string& Scene::GetName() const
@@ -315,10 +400,19 @@ void Scene::EnableEntity(Entity ent)
   m_registry.EnableEntity(ent);
 }
 
+bool Scene::operator==(const Scene& other) const
+{
+  return m_name == other.m_name &&                           //
+         m_registry == other.m_registry &&                   //
+         m_active_camera == other.m_active_camera &&         //
+         m_textures_registry == other.m_textures_registry && //
+         m_attached == other.m_attached;
+}
+
 void Scene::SetActiveCamera(Opt<Entity> activeCamera)
 {
   GE_PROFILE;
-  auto cameras = m_registry.Group<CameraComponent>();
+  const auto& cameras = m_registry.Group<CameraComponent>();
   for (const Entity& ent : cameras)
   {
     if (ent == activeCamera)
@@ -328,13 +422,25 @@ void Scene::SetActiveCamera(Opt<Entity> activeCamera)
   m_active_camera = activeCamera;
 }
 
+void Scene::EnqueueToCreate(std::string&& name, std::function<void(Entity)>&& onCreated)
+{
+  GE_PROFILE;
+  m_commands.Create(
+    [this, tag = std::move(name), fun = std::move(onCreated)](Entity ent)
+    {
+      AddComponent<TagComponent>(ent, std::string{ tag });
+      if (fun)
+        fun(ent);
+    });
+}
+
 void Scene::EnqueueToDestroy(Opt<Entity> ent)
 {
   GE_PROFILE;
   if (!ent)
     return;
 
-  GetQueue().push_back(ent.value());
+  m_commands.Destroy(ent.value());
 }
 
 void Scene::OnAttach()
@@ -348,31 +454,31 @@ void Scene::UpdateLightSourcesPosition(TimeStep& /*ts*/,
                                        const Vec3& viewPosition)
 {
   GE_PROFILE;
-  const std::vector<Entity> light_sources = m_registry.Group<LightSourceComponent>();
+  const std::vector<Entity>& light_sources = m_registry.Group<LightSourceComponent>();
   if (light_sources.empty())
     return;
 
-  { // Reset ambient and light colors
-    Renderer::SetAmbientLight(Colors::WHITE, 1.0f);
-    Renderer::SetLightSources({});
+  // Gizmos are recolored only when their light changed color, so the others keep their version
+  for (const Entity ent : light_sources)
+  {
+    const auto& lp = std::as_const(m_registry).GetComponent<LightSourceComponent>(ent);
+    const std::vector<VertexStruct>& vertices = lp.GetDrawable().GetVerticesData().GetData();
+    const Vec4 color = lp.GetColor().ToVec4();
+    if (lp.IsActive() && !vertices.empty() && vertices.front().color != color)
+      m_registry.GetComponent<LightSourceComponent>(ent).GetDrawable().UpdateColor(lp.GetColor());
   }
 
-  Renderer::Batch::Begin(cameraMatrix, viewPosition);
+  // Gizmos are drawn unlit, so the lights of the scene are left as they are
+  Renderer::Batch::Begin(cameraMatrix, viewPosition, MaterialShading::UNLIT);
   for (auto ent : light_sources)
   {
     auto& lp = m_registry.GetComponent<LightSourceComponent>(ent);
     if (!lp.IsActive())
       continue;
     Mat4 translate = Transform::Translate(lp.GetPos()) * Transform::Scale(0.1f, 0.1f, 0.1f);
-    lp.GetDrawable().UpdateColor(lp.GetColor());
-    auto vertices = lp.GetDrawable().GetVerticesData();
-    auto indices = lp.GetDrawable().GetIndicesData();
-    Renderer::Batch::PushObject(std::move(vertices), indices, translate);
+    Renderer::Batch::PushObject(lp.GetDrawable().GetVerticesData(),
+                                lp.GetDrawable().GetIndicesData(),
+                                translate);
   }
   Renderer::Batch::End();
-
-  { // Reset ambient and light colors
-    Renderer::SetAmbientLight(Colors::BLACK, 0.0f);
-    Renderer::SetLightSources({});
-  }
 }
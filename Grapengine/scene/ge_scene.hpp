@@ -3,6 +3,7 @@
 
 #include "core/ge_time_step.hpp"
 #include "events/ge_event.hpp"
+#include "ge_command_buffer.hpp"
 #include "ge_ec_registry.hpp"
 #include "ge_textures_registry.hpp"
 
@@ -12,16 +13,54 @@ namespace GE
   class Scene
   {
   public:
-    static Ptr<Scene> Make(const std::string& name);
+    static Ptr<Scene> Make(const std::string& name,
+                           StorageMode storageMode = StorageMode::SPARSE_SET);
 
-    Scene(const std::string& name);
+    Scene(const std::string& name, StorageMode storageMode = StorageMode::SPARSE_SET);
+    Scene(const Scene&) = delete;
+    Scene& operator=(const Scene&) = delete;
+
+    /**
+     * Releases the meshes referenced by the drawn entities
+     */
+    ~Scene();
 
     Entity CreateEntity(std::string&& name);
 
-    void PushEntity(Entity entity);
+    /**
+     * Create many entities at once as copies of a prefab entity
+     * @param count number of entities to be created
+     * @param prefab entity whose components, including its tag, are copied
+     * @return created entities
+     */
+    std::vector<Entity> CreateEntities(u32 count, Entity prefab);
+
+    /**
+     * Insert an entity with a known handle
+     * @param entity entity to insert
+     * @return inserted entity, which differs from the given one when its handle was remapped
+     */
+    Entity PushEntity(Entity entity);
 
+    /**
+     * Deferred structural changes, which can be recorded from any thread and are applied at the
+     * end of the scene update
+     */
+    void EnqueueToCreate(std::string&& name, std::function<void(Entity)>&& onCreated = {});
     void EnqueueToDestroy(Opt<Entity> ent);
 
+    template <typename Component>
+    void EnqueueAddComponent(Entity ent, Component component)
+    {
+      m_commands.AddComponent<Component>(ent, std::move(component));
+    }
+
+    template <typename Component>
+    void EnqueueRemoveComponent(Entity ent)
+    {
+      m_commands.RemoveComponent<Component>(ent);
+    }
+
     /**
      * Called when already exists a GL valid context
      */
@@ -37,10 +76,7 @@ namespace GE
     void SetActiveCamera(Opt<Entity> activeCamera);
 
     void OnEachEntity(const std::function<void(Entity)>& fun);
-    const std::list<Entity>& GetEntitiesList() const;
-    const std::set<Entity>& GetEntitiesSet() const;
-
-    const std::vector<VarComponent>& GetComponents(const Entity& ent) const;
+    const std::vector<Entity>& GetEntities() const;
 
     const std::string& GetName() const;
     void SetName(const std::string& name);
@@ -52,15 +88,15 @@ namespace GE
     void DisableEntity(Entity ent);
     void EnableEntity(Entity ent);
 
-    [[nodiscard]] bool operator==(const Scene& other) const = default;
+    [[nodiscard]] bool operator==(const Scene& other) const;
 
     // Registry wrappers functions
 
     template <typename Component, typename... Args>
-    void AddComponent(const Entity& ent, Args&&... args)
+    Component& AddComponent(const Entity& ent, Args&&... args)
     {
       GE_PROFILE;
-      m_registry.AddComponent<Component>(ent, std::forward<Args>(args)...);
+      return m_registry.AddComponent<Component>(ent, std::forward<Args>(args)...);
     }
 
     template <typename Component>
@@ -94,6 +130,12 @@ namespace GE
       return m_registry.Has<Component>(ent);
     }
 
+    template <typename Visitor>
+    void VisitComponents(const Entity& ent, Visitor&& visitor) const
+    {
+      m_registry.VisitComponents(ent, std::forward<Visitor>(visitor));
+    }
+
     template <typename Component>
     void RemoveComponent(Entity ent)
     {
@@ -110,15 +152,44 @@ namespace GE
     void UpdateLightSources() const;
     void UpdateAmbientLight() const;
 
-    void DestroyFromQueue();
+    void FlushCommands();
 
     [[nodiscard]] Opt<Entity> RetrieveActiveCamera() const;
 
+    struct ModelMatrixCache
+    {
+      u32 entity_handle = std::numeric_limits<u32>::max();
+      u64 version = 0;
+      Mat4 model;
+    };
+
+    /**
+     * Mesh referenced by an entity drawn as an instance, and the last frame it was drawn
+     */
+    struct MeshCache
+    {
+      u32 entity_handle = std::numeric_limits<u32>::max();
+      u64 version = 0;
+      u32 mesh = 0;
+      u64 frame = 0;
+    };
+
+    /**
+     * Release the meshes of the entities not drawn as instances in the current frame, since
+     * they were destroyed, lost their primitive or became translucent
+     */
+    void ReleaseUndrawnMeshes();
+
     std::string m_name;
     ECRegistry m_registry;
+    CommandBuffer m_commands;
     Opt<Entity> m_active_camera;
     TexturesRegistry m_textures_registry;
     bool m_attached = false;
+    std::vector<ModelMatrixCache> m_model_matrices;
+    std::vector<MeshCache> m_meshes;
+    std::vector<u32> m_meshes_in_use;
+    u64 m_frame = 0;
   };
 
 } // GE
@@ -2,12 +2,44 @@
 
 #include "core/ge_context.hpp"
 #include "profiling/ge_profiler.hpp"
+#include "renderer/ge_frame_uniforms.hpp"
 
 using namespace GE;
 
+namespace
+{
+  /**
+   * Decoded textures uploaded in a frame, so many textures ready at once do not stall it
+   */
+  constexpr u64 UPLOADS_PER_FRAME = 4;
+
+  /**
+   * What the textures sharing an array have in common. Uncompressed textures get the complete
+   * mip chain, while compressed ones keep the levels of their file.
+   */
+  struct ArrayLayout
+  {
+    Dimensions dimension;
+    PixelFormat format;
+    u32 levels;
+
+    [[nodiscard]] bool operator==(const ArrayLayout& rhs) const = default;
+  };
+
+  ArrayLayout GetArrayLayout(const Image& image)
+  {
+    const u32 levels = image.IsCompressed() ? image.levels : Image::MipLevelsCount(image.dimension);
+    return { image.dimension, image.format, levels };
+  }
+
+  ArrayLayout GetArrayLayout(const TextureArray& array)
+  {
+    return { array.GetDimension(), array.GetFormat(), array.GetLevelsCount() };
+  }
+}
+
 TexturesRegistry::TexturesRegistry() : m_texture_next_slot(1)
 {
-  m_textures_pointers.emplace(Texture2D::EMPTY_TEX_SLOT, nullptr);
   m_textures_paths.emplace(Texture2D::EMPTY_TEX_SLOT, "");
 }
 
@@ -16,7 +48,6 @@ TexturesRegistry::TexturesRegistry(const std::map<u32, std::string>& texturePath
 {
   for (const auto& [slot, tex_path] : texturePaths)
   {
-    m_textures_pointers.emplace(slot, nullptr);
     m_textures_paths.emplace(slot, tex_path);
     if (slot > m_texture_next_slot)
       m_texture_next_slot = slot;
@@ -27,15 +58,10 @@ TexturesRegistry::TexturesRegistry(const std::map<u32, std::string>& texturePath
 u32 TexturesRegistry::Register(const std::filesystem::path& texturePath, bool alsoLoad)
 {
   GE_PROFILE;
-  Ptr<Texture2D> tex = nullptr;
-  if (alsoLoad)
-  {
-    tex = Texture2D::Make(texturePath);
-    GE_ASSERT(tex != nullptr, "Failed to load texture: {}", texturePath.string());
-  }
   u32 texture_slot = m_texture_next_slot++;
   GE_ASSERT(!m_textures_paths.contains(texture_slot), "Texture already exists: {}", texture_slot);
-  m_textures_pointers.emplace(texture_slot, tex);
+  if (alsoLoad)
+    m_loader.Request(texture_slot, texturePath);
   m_textures_paths.emplace(texture_slot, texturePath.string());
   return texture_slot;
 }
@@ -45,37 +71,189 @@ void TexturesRegistry::RegisterAtSlot(const std::filesystem::path& texturePath,
   GE_PROFILE;
   GE_ASSERT(!m_textures_paths.contains(slot), "Texture already exists: {}", slot);
 
-  m_textures_pointers.emplace(slot, nullptr);
   m_textures_paths.emplace(slot, texturePath.string());
 
-  m_texture_next_slot = std::ranges::max(m_textures_pointers | std::views::keys) + 1;
+  m_texture_next_slot = std::ranges::max(m_textures_paths | std::views::keys) + 1;
 }
 
 void TexturesRegistry::LoadTextures()
 {
   for (const auto& [slot, tex_path] : m_textures_paths)
   {
-    if (m_textures_pointers.contains(slot) && m_textures_pointers.at(slot) != nullptr)
+    if (slot == Texture2D::EMPTY_TEX_SLOT || m_locations.contains(slot) || IsLoading(slot))
       continue;
 
-    if (slot == Texture2D::EMPTY_TEX_SLOT)
+    m_loader.Request(slot, tex_path);
+  }
+}
+
+bool TexturesRegistry::Update()
+{
+  GE_PROFILE;
+  std::map<u32, Image> images;
+  // The white texture goes first, so it is at the first layer of the first array
+  if (!m_locations.contains(Texture2D::EMPTY_TEX_SLOT))
+    images.emplace(Texture2D::EMPTY_TEX_SLOT, Image::White());
+  for (auto& [slot, image] : m_loader.TakeDecoded(UPLOADS_PER_FRAME))
+    images.insert_or_assign(slot, std::move(image));
+
+  bool changed = false;
+  if (!images.empty())
+    changed = AddImages(std::move(images));
+  changed = FinishUploads() || changed;
+  if (!changed)
+    return false;
+
+  m_layers.assign(m_locations.rbegin()->first + 1, 0);
+  for (const auto& [slot, location] : m_locations)
+    m_layers.at(slot) = location;
+  return true;
+}
+
+void TexturesRegistry::BindTextures() const
+{
+  for (u32 unit = 0; unit < m_arrays.size(); unit++)
+    m_arrays.at(unit)->Bind(unit);
+}
+
+std::span<const i32> TexturesRegistry::GetTextureLayers() const
+{
+  return m_layers;
+}
+
+bool TexturesRegistry::IsLoading(u32 slot) const
+{
+  return m_loader.IsPending(slot) ||
+         std::ranges::find(m_uploads, slot, [](const Upload& u) { return u.slot; }) !=
+           m_uploads.end();
+}
+
+bool TexturesRegistry::AddImages(std::map<u32, Image>&& images)
+{
+  GE_PROFILE;
+  // Slots of the new textures of each array, with arrays for new layouts created below
+  std::vector<ArrayLayout> layouts;
+  for (const Ptr<TextureArray>& array : m_arrays)
+    layouts.push_back(GetArrayLayout(*array));
+  std::vector<std::vector<u32>> new_slots(m_arrays.size());
+  for (const auto& [slot, image] : images)
+  {
+    GE_ASSERT(slot < MAX_TEXTURE_SLOTS, "Texture slot {} beyond the table of layers", slot);
+    if (image.IsEmpty())
+      continue;
+
+    const ArrayLayout layout = GetArrayLayout(image);
+    const auto it = std::ranges::find(layouts, layout);
+    if (it != layouts.end())
+    {
+      new_slots.at(u64(it - layouts.begin())).push_back(slot);
+      continue;
+    }
+
+    GE_ASSERT(layouts.size() < MAX_TEXTURE_ARRAYS,
+              "Textures of more than {} dimensions and formats are not supported",
+              MAX_TEXTURE_ARRAYS);
+    layouts.push_back(layout);
+    new_slots.push_back({ slot });
+  }
+  m_arrays.resize(layouts.size());
+  m_arrays_used_layers.resize(layouts.size(), 0);
+
+  bool changed = false;
+  for (u64 arr_idx = 0; arr_idx < m_arrays.size(); arr_idx++)
+  {
+    const std::vector<u32>& slots = new_slots.at(arr_idx);
+    if (slots.empty())
+      continue;
+
+    // Arrays are recreated with twice the layers when full, keeping the existing ones
+    u32& used_layers = m_arrays_used_layers.at(arr_idx);
+    Ptr<TextureArray>& array = m_arrays.at(arr_idx);
+    const u32 required_layers = used_layers + u32(slots.size());
+    if (array == nullptr || array->GetLayersCount() < required_layers)
+    {
+      const auto& [dimension, format, levels] = layouts.at(arr_idx);
+      auto grown = TextureArray::Make(dimension, std::bit_ceil(required_layers), format, levels);
+      if (array != nullptr)
+        grown->CopyLayers(*array);
+      array = grown;
+    }
+
+    for (const u32 slot : slots)
+    {
+      const u32 layer = used_layers++;
+      const i32 location = i32(arr_idx) << TEXTURE_LAYER_BITS | i32(layer);
+      const Image& image = images.at(slot);
+      // The levels of uncompressed textures missing from the image are computed on the GPU
+      const bool generate_mipmaps =
+        !image.IsCompressed() && image.levels < array->GetLevelsCount();
+      if (slot == Texture2D::EMPTY_TEX_SLOT)
+      {
+        array->SetLayer(layer, image);
+        if (generate_mipmaps)
+          array->GenerateMipmaps(layer);
+        m_locations[slot] = location;
+        changed = true;
+        continue;
+      }
+
+      auto pixels = MakeRef<PixelBuffer>(image);
+      array->SetLayer(layer, *pixels);
+      pixels->Fence();
+      m_uploads.push_back({ slot, location, pixels, generate_mipmaps });
+    }
+  }
+  return changed;
+}
+
+bool TexturesRegistry::FinishUploads()
+{
+  // Slots are switched to their texture only once the GPU has read its pixels
+  bool changed = false;
+  for (auto it = m_uploads.begin(); it != m_uploads.end();)
+  {
+    if (!it->pixels->IsDone())
     {
-      m_textures_pointers.at(slot) = Texture2D::Make();
+      ++it;
       continue;
     }
 
-    auto tex = Texture2D::Make(tex_path);
-    m_textures_pointers.at(slot) = tex;
+    // Generated after the fence, so they do not wait for the pixels to be read, and only for the
+    // new layer instead of the whole array
+    if (it->generate_mipmaps)
+    {
+      const auto array = u64(it->location >> TEXTURE_LAYER_BITS);
+      const auto layer = u32(it->location & ((1 << TEXTURE_LAYER_BITS) - 1));
+      m_arrays.at(array)->GenerateMipmaps(layer);
+    }
+    m_locations[it->slot] = it->location;
+    changed = true;
+    it = m_uploads.erase(it);
   }
+  return changed;
 }
 
-void TexturesRegistry::BindTexture(u32 slot)
+std::vector<TexturesRegistry::TextureMemory> TexturesRegistry::GetMemoryReport() const
 {
-  GE_ASSERT(m_textures_pointers.contains(slot), "Texture not found at slot {}", slot);
-  GE_ASSERT(m_textures_pointers.at(slot) != nullptr, "Texture {} is null", slot);
+  std::vector<TextureMemory> report;
+  for (const auto& [slot, location] : m_locations)
+  {
+    const TextureArray& array = *m_arrays.at(u64(location >> TEXTURE_LAYER_BITS));
+    report.push_back({ slot,
+                       array.GetDimension(),
+                       array.GetFormat(),
+                       array.GetLevelsCount(),
+                       array.GetLayerSize() });
+  }
+  return report;
+}
 
-  const auto& tex = m_textures_pointers.at(slot);
-  tex->Bind(slot);
+u64 TexturesRegistry::GetAllocatedMemory() const
+{
+  u64 size = 0;
+  for (const Ptr<TextureArray>& array : m_arrays)
+    size += array->GetLayerSize() * array->GetLayersCount();
+  return size;
 }
 
 const std::map<u32, std::string>& TexturesRegistry::GetTexturesPaths() const
@@ -1,31 +1,96 @@
 #ifndef TEXTURES_REGISTER_HPP
 #define TEXTURES_REGISTER_HPP
 
+#include "renderer/ge_image.hpp"
 #include "renderer/ge_texture_2d.hpp"
+#include "renderer/ge_texture_array.hpp"
+#include "renderer/ge_texture_loader.hpp"
 
 namespace GE
 {
+  /**
+   * Textures of a scene, identified by a slot. The textures are stored as layers of texture
+   * arrays, one per dimension, so all of them are bound at once regardless of how many objects
+   * use them. The slots are resolved to their array and layer by the table of the shaders.
+   * Images are decoded in the background and uploaded through pixel buffers, and a slot is
+   * shown with the white texture until its upload is done.
+   */
   class TexturesRegistry
   {
   public:
+    struct TextureMemory
+    {
+      u32 slot;
+      Dimensions dimension;
+      PixelFormat format;
+      u32 levels;
+      u64 bytes;
+    };
+
     explicit TexturesRegistry();
     TexturesRegistry(const std::map<u32, std::string>& texturePaths);
 
     u32 Register(const std::filesystem::path& texturePath, bool alsoLoad);
     void RegisterAtSlot(const std::filesystem::path& texturePath, u32 slot);
 
+    /**
+     * Start decoding the textures not loaded yet
+     */
     void LoadTextures();
 
-    void BindTexture(u32 slot);
+    /**
+     * Upload some of the decoded textures to the texture arrays, and tell whether the table of
+     * layers has changed because uploads are done
+     */
+    bool Update();
+
+    /**
+     * Bind each texture array to the unit of its index
+     */
+    void BindTextures() const;
+
+    /**
+     * Texture array and layer of each slot, packed as (array << 16 | layer). Slots not loaded
+     * yet are at the first layer of the first array, the white texture.
+     */
+    [[nodiscard]] std::span<const i32> GetTextureLayers() const;
+
+    /**
+     * Video memory used by each uploaded texture, with all its mip levels
+     */
+    [[nodiscard]] std::vector<TextureMemory> GetMemoryReport() const;
+
+    /**
+     * Video memory of the texture arrays, including the layers reserved for the next textures
+     */
+    [[nodiscard]] u64 GetAllocatedMemory() const;
 
     const std::map<u32, std::string>& GetTexturesPaths() const;
 
     [[nodiscard]] bool operator==(const TexturesRegistry& rhs) const;
 
   private:
+    struct Upload
+    {
+      u32 slot;
+      i32 location;
+      Ptr<PixelBuffer> pixels;
+      bool generate_mipmaps;
+    };
+
+    [[nodiscard]] bool IsLoading(u32 slot) const;
+    [[nodiscard]] bool AddImages(std::map<u32, Image>&& images);
+    [[nodiscard]] bool FinishUploads();
+
     std::map<u32, std::string> m_textures_paths;
-    std::map<u32, Ptr<Texture2D>> m_textures_pointers;
     u32 m_texture_next_slot;
+
+    TextureLoader m_loader;
+    std::vector<Upload> m_uploads;
+    std::map<u32, i32> m_locations;
+    std::vector<Ptr<TextureArray>> m_arrays;
+    std::vector<u32> m_arrays_used_layers;
+    std::vector<i32> m_layers;
   };
 
 } // GE
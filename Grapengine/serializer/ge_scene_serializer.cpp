@@ -31,12 +31,13 @@ std::string SceneSerializer::Serialize() const
     {
       out << YAML::BeginMap; // Entity node
       out << YAML::Key << Fields::ENTITY_ID << YAML::Value << ent.handle;
-      const std::vector<VarComponent>& comps = m_scene->GetComponents(ent);
-      for (const VarComponent& c : comps)
-      {
-        std::visit<void>(ComponentSerializer(out), c);
-        GE_ASSERT_NO_MSG(out.good());
-      }
+      const ComponentSerializer serializer{ out };
+      m_scene->VisitComponents(ent,
+                               [&](const auto& c)
+                               {
+                                 serializer(c);
+                                 GE_ASSERT_NO_MSG(out.good());
+                               });
       out << YAML::EndMap; // Entity node
     });
 
@@ -83,8 +84,7 @@ void SceneSerializer::Deserialize(const std::string& sceneString)
   for (const auto& ent_node : entities_node)
   {
     u32 ent_handle = ent_node[Fields::ENTITY_ID].as<u32>();
-    Entity ent{ ent_handle };
-    m_scene->PushEntity(ent);
+    const Entity ent = m_scene->PushEntity(Entity{ ent_handle });
 
     auto deserializer = ComponentDeserializer(ent_node);
     m_scene->PushComponent<TagComponent>(ent, deserializer.GetTag());
@@ -176,9 +176,32 @@ void EditorLayer::OnImGuiUpdate(TimeStep ts)
     //    ImGui::Text("Draw calls: %05" PRIu64, stats.draw_calls);
     ImGui::Text("Vertices count: %" PRIu64, stats.vertices_count);
     ImGui::Text("Indices count: %" PRIu64, stats.indices_count);
+    ImGui::Text("Instances count: %" PRIu64, stats.instances_count);
+    ImGui::Text("Uniform uploads: %" PRIu64, stats.uniform_uploads);
+    ImGui::Text("GL state calls avoided: %" PRIu64, stats.state_calls_avoided);
+    ImGui::Text("Attachment allocations: %" PRIu64, stats.attachment_allocations);
     ImGui::Text("Time spent to batch: %f s", static_cast<f64>(stats.time_spent) * 1e-9);
     ImGui::Text("FPS %.2f", fps);
     s_timer_checker += ts.Secs();
+
+    const TexturesRegistry& tex_reg = m_scene->GetTextureRegistry();
+    if (ImGui::TreeNode("Textures memory"))
+    {
+      const std::map<u32, std::string>& paths = tex_reg.GetTexturesPaths();
+      for (const auto& [slot, dim, format, levels, bytes] : tex_reg.GetMemoryReport())
+      {
+        ImGui::Text("%u %s: %ux%u %s, %u levels, %" PRIu64 " KiB",
+                    slot,
+                    paths.at(slot).c_str(),
+                    dim.width,
+                    dim.height,
+                    Image::FormatName(format).data(),
+                    levels,
+                    bytes / 1024);
+      }
+      ImGui::Text("Allocated: %" PRIu64 " KiB", tex_reg.GetAllocatedMemory() / 1024);
+      ImGui::TreePop();
+    }
   }
   ImGui::End();
 
@@ -196,8 +219,11 @@ void EditorLayer::OnImGuiUpdate(TimeStep ts)
   m_viewport_dimension.height = u32(vp_size.y);
   RendererID tex = m_fb->GetColorAttachmentID();
   const auto [w, h] = m_fb->GetDimension();
+  const auto [allocated_w, allocated_h] = m_fb->GetAllocatedDimension();
   ImVec2 size{ f32(w), f32(h) };
-  ImGui::Image(TypeUtils::ToVoidPtr(u32(tex)), size, { 0, 1 }, { 1, 0 });
+  // The frame covers the bottom left corner of the attachment, shown flipped vertically
+  const ImVec2 uv_max{ f32(w) / f32(allocated_w), f32(h) / f32(allocated_h) };
+  ImGui::Image(TypeUtils::ToVoidPtr(u32(tex)), size, { 0, uv_max.y }, { uv_max.x, 0 });
   ImGui::End();
   ImGui::PopStyleVar();
 
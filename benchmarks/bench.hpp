@@ -0,0 +1,23 @@
+#ifndef GRAPENGINE_BENCH_HPP
+#define GRAPENGINE_BENCH_HPP
+
+#include "core/ge_platform.hpp"
+
+namespace Bench
+{
+  /**
+   * Run the function once for each size and print the total time and the time per element, so
+   * the scaling of the measured operation can be read from the last column
+   * @param name name of the benchmark
+   * @param sizes amounts of elements handled by each run
+   * @param run function called with the amount of elements of the run
+   */
+  void Run(const std::string& name,
+           const std::vector<u64>& sizes,
+           const std::function<void(u64)>& run);
+
+  void BatchBuilder();
+  void VertexTransform();
+}
+
+#endif // GRAPENGINE_BENCH_HPP
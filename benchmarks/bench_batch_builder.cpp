@@ -0,0 +1,37 @@
+#include "bench.hpp"
+
+#include "math/ge_transformations.hpp"
+#include "renderer/ge_batch_builder.hpp"
+
+void Bench::BatchBuilder()
+{
+  const GE::VerticesData triangle{ {
+    { GE::Vec3{ 0, 0, 0 }, GE::Vec2{ 0, 0 }, GE::Vec4{ 1, 1, 1, 1 }, GE::Vec3{ 0, 0, 1 }, 0 },
+    { GE::Vec3{ 1, 0, 0 }, GE::Vec2{ 1, 0 }, GE::Vec4{ 1, 1, 1, 1 }, GE::Vec3{ 0, 0, 1 }, 0 },
+    { GE::Vec3{ 0, 1, 0 }, GE::Vec2{ 0, 1 }, GE::Vec4{ 1, 1, 1, 1 }, GE::Vec3{ 0, 0, 1 }, 0 },
+  } };
+  const std::vector<u32> indices{ 0, 1, 2 };
+
+  GE::BatchBuilder builder;
+  std::vector<GE::BatchDraw> draws;
+  std::vector<GE::PackedVertexStruct> vertices;
+  std::vector<u32> batch_indices;
+  Bench::Run("BatchBuilder::Push, Layout and Write",
+             { 1'000, 10'000, 100'000, 1'000'000 },
+             [&](u64 count)
+             {
+               draws.clear();
+               for (u64 i = 0; i < count; i++)
+               {
+                 const GE::Mat4 model = GE::Transform::Translate(f32(i), 0, 0);
+                 draws.push_back({ triangle.GetData(), indices, model });
+               }
+
+               builder.Begin(GE::Vec3{});
+               builder.Push(draws);
+               const auto [vertices_count, indices_count] = builder.Layout();
+               vertices.resize(vertices_count);
+               batch_indices.resize(indices_count);
+               builder.Write(vertices, batch_indices);
+             });
+}
@@ -0,0 +1,24 @@
+#include "bench.hpp"
+
+void Bench::Run(const std::string& name,
+                const std::vector<u64>& sizes,
+                const std::function<void(u64)>& run)
+{
+  std::cout << name << '\n';
+  for (u64 size : sizes)
+  {
+    const u64 start = GE::Platform::GetCurrentTimeNS();
+    run(size);
+    const u64 elapsed = GE::Platform::GetCurrentTimeNS() - start;
+    std::cout << "  " << size << " elements: " << elapsed / 1'000'000 << " ms, "
+              << elapsed / size << " ns/element\n";
+  }
+}
+
+int main()
+{
+  GE::Logger::Init();
+  Bench::BatchBuilder();
+  Bench::VertexTransform();
+  return 0;
+}
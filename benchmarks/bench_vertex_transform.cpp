@@ -0,0 +1,21 @@
+#include "bench.hpp"
+
+#include "math/ge_transformations.hpp"
+#include "renderer/ge_buffer_handler.hpp"
+
+void Bench::VertexTransform()
+{
+  const GE::Mat4 model = GE::Transform::Translate(1, 2, 3) * GE::Transform::RotateY(45) *
+                         GE::Transform::Scale(2, 2, 2);
+  const GE::VertexStruct vertex{
+    GE::Vec3{ 1, 2, 3 }, GE::Vec2{ 0, 0 }, GE::Vec4{ 1, 1, 1, 1 }, GE::Vec3{ 0, 0, 1 }, 0
+  };
+
+  Bench::Run("BufferHandler::UpdatePosition",
+             { 1'000, 10'000, 100'000, 1'000'000 },
+             [&](u64 count)
+             {
+               GE::VerticesData vd{ std::vector<GE::VertexStruct>(count, vertex) };
+               GE::BufferHandler::UpdatePosition(vd, model);
+             });
+}
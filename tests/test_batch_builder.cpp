@@ -0,0 +1,204 @@
+#include "math/ge_transformations.hpp"
+#include "renderer/ge_batch_builder.hpp"
+
+#include <gtest/gtest.h>
+
+#if defined(GE_CLANG_COMPILER)
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+
+using namespace GE;
+
+namespace
+{
+  VerticesData MakeTriangle(f32 alpha, u32 slot = 0)
+  {
+    const Vec4 color{ 1, 1, 1, alpha };
+    const Vec3 normal{ 0, 0, 1 };
+    return VerticesData{ {
+      { Vec3{ 0, 0, 0 }, Vec2{ 0, 0 }, color, normal, slot },
+      { Vec3{ 1, 0, 0 }, Vec2{ 1, 0 }, color, normal, slot },
+      { Vec3{ 0, 1, 0 }, Vec2{ 0, 1 }, color, normal, slot },
+    } };
+  }
+
+  struct Batch
+  {
+    std::vector<PackedVertexStruct> vertices;
+    std::vector<u32> indices;
+  };
+
+  Batch Build(BatchBuilder& builder)
+  {
+    const auto [vertices_count, indices_count] = builder.Layout();
+    Batch batch{ std::vector<PackedVertexStruct>(vertices_count),
+                 std::vector<u32>(indices_count) };
+    builder.Write(batch.vertices, batch.indices);
+    return batch;
+  }
+}
+
+TEST(BatchBuilder, SortsByDrawKey)
+{
+  const VerticesData translucent = MakeTriangle(0.5F);
+  const VerticesData opaque = MakeTriangle(1.0F);
+  const std::vector<u32> indices{ 0, 1, 2 };
+
+  BatchBuilder builder;
+  builder.Begin(Vec3{ 0, 0, 0 });
+  builder.Push({ translucent.GetData(), indices, Transform::Translate(0, 0, -1), true });
+  builder.Push({ opaque.GetData(), indices, Transform::Translate(0, 0, -5) });
+  builder.Push({ translucent.GetData(), indices, Transform::Translate(0, 0, -9), true });
+  builder.Push({ opaque.GetData(), indices, Transform::Translate(0, 0, -2) });
+  const Batch batch = Build(builder);
+
+  // Opaque front to back, then translucent back to front
+  const std::vector<PackedVertexStruct>& vertices = batch.vertices;
+  ASSERT_EQ(vertices.size(), 12u);
+  EXPECT_FLOAT_EQ(vertices[0].position.z, -2);
+  EXPECT_FLOAT_EQ(vertices[3].position.z, -5);
+  EXPECT_FLOAT_EQ(vertices[6].position.z, -9);
+  EXPECT_FLOAT_EQ(vertices[9].position.z, -1);
+
+  const std::vector<u32> expected_indices{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+  EXPECT_EQ(batch.indices, expected_indices);
+}
+
+TEST(BatchBuilder, OffsetsIndicesByBaseVertex)
+{
+  const VerticesData triangle = MakeTriangle(1.0F);
+  const std::vector<u32> first_indices{ 2, 1, 0 };
+  const std::vector<u32> second_indices{ 0, 0, 0 };
+  const std::vector<u32> third_indices{ 1, 2, 0 };
+
+  BatchBuilder builder;
+  builder.Begin(Vec3{ 0, 0, 0 });
+  builder.Push({ triangle.GetData(), first_indices, Transform::Translate(0, 0, -1) });
+  builder.Push({ triangle.GetData(), second_indices, Transform::Translate(0, 0, -2) });
+  builder.Push({ triangle.GetData(), third_indices, Transform::Translate(0, 0, -3) });
+  const Batch batch = Build(builder);
+
+  const std::vector<u32> expected_indices{ 2, 1, 0, 3, 3, 3, 7, 8, 6 };
+  EXPECT_EQ(batch.indices, expected_indices);
+
+  // Objects without indices have nothing to draw
+  builder.Begin(Vec3{ 0, 0, 0 });
+  builder.Push({ triangle.GetData(), {}, Transform::Translate(0, 0, -1) });
+  const Batch empty_batch = Build(builder);
+  EXPECT_TRUE(empty_batch.indices.empty());
+  EXPECT_TRUE(empty_batch.vertices.empty());
+}
+
+TEST(BatchBuilder, BuildsDrawListInParallel)
+{
+  const VerticesData triangle = MakeTriangle(1.0F);
+  const std::vector<u32> indices{ 0, 1, 2 };
+
+  // Farther objects are pushed first, so sorting reverses the draw list
+  constexpr u32 count = 10'000;
+  std::vector<BatchDraw> draws;
+  for (u32 i = 0; i < count; i++)
+    draws.push_back({ triangle.GetData(), indices, Transform::Translate(0, 0, -f32(count - i)) });
+
+  BatchBuilder builder;
+  builder.Begin(Vec3{ 0, 0, 0 });
+  builder.Push(draws);
+  const Batch batch = Build(builder);
+
+  const std::vector<PackedVertexStruct>& vertices = batch.vertices;
+  const std::vector<u32>& batch_indices = batch.indices;
+  ASSERT_EQ(vertices.size(), 3u * count);
+  ASSERT_EQ(batch_indices.size(), 3u * count);
+  for (u32 i = 0; i < count; i++)
+  {
+    ASSERT_FLOAT_EQ(vertices[3 * i].position.z, -f32(i + 1));
+    ASSERT_EQ(batch_indices[3 * i + 2], 3 * i + 2);
+  }
+}
+
+TEST(BatchBuilder, WritesIntoExternalBuffers)
+{
+  const VerticesData triangle = MakeTriangle(1.0F);
+  const std::vector<u32> indices{ 0, 1, 2 };
+
+  BatchBuilder builder;
+  builder.Begin(Vec3{ 0, 0, 0 });
+  builder.Push({ triangle.GetData(), indices, Transform::Translate(0, 0, -2) });
+  builder.Push({ triangle.GetData(), indices, Transform::Translate(0, 0, -1) });
+
+  const auto [vertices_count, indices_count] = builder.Layout();
+  ASSERT_EQ(vertices_count, 6u);
+  ASSERT_EQ(indices_count, 6u);
+
+  std::vector<PackedVertexStruct> vertices(vertices_count);
+  std::vector<u32> batch_indices(indices_count);
+  builder.Write(vertices, batch_indices);
+  EXPECT_FLOAT_EQ(vertices[0].position.z, -1);
+  EXPECT_FLOAT_EQ(vertices[3].position.z, -2);
+
+  const std::vector<u32> expected_indices{ 0, 1, 2, 3, 4, 5 };
+  EXPECT_EQ(batch_indices, expected_indices);
+}
+
+TEST(BatchBuilder, TransformsLargeObjects)
+{
+  // Enough vertices for the object to be transformed in several blocks
+  constexpr u32 count = 1'000;
+  std::vector<VertexStruct> data;
+  for (u32 i = 0; i < count; i++)
+    data.push_back({ Vec3{ f32(i), 0, 0 }, Vec2{ 0, 0 }, Vec4{ 1, 1, 1, 1 }, Vec3{ 0, 0, 1 }, 0 });
+  const VerticesData object{ data };
+  const std::vector<u32> indices{ 0, count / 2, count - 1 };
+
+  BatchBuilder builder;
+  builder.Begin(Vec3{ 0, 0, 0 });
+  builder.Push({ object.GetData(), indices, Transform::Translate(0, 2, 0) });
+  const Batch batch = Build(builder);
+
+  const std::vector<PackedVertexStruct>& vertices = batch.vertices;
+  ASSERT_EQ(vertices.size(), count);
+  for (u32 i = 0; i < count; i++)
+  {
+    ASSERT_FLOAT_EQ(vertices[i].position.x, f32(i));
+    ASSERT_FLOAT_EQ(vertices[i].position.y, 2);
+  }
+  EXPECT_EQ(batch.indices, indices);
+}
+
+TEST(BatchBuilder, SplitsRangesByTextureArray)
+{
+  // Slot 0 is in the first array, and slots 1 and 2 are layers of the second one
+  const std::vector<i32> texture_layers{ 0, 1 << 16, 1 << 16 | 1 };
+  const VerticesData first_array = MakeTriangle(1.0F, 0);
+  const VerticesData second_array = MakeTriangle(1.0F, 2);
+  const VerticesData translucent_first = MakeTriangle(0.5F, 0);
+  const VerticesData translucent_second = MakeTriangle(0.5F, 1);
+  const std::vector<u32> indices{ 0, 1, 2 };
+
+  BatchBuilder builder;
+  builder.Begin(Vec3{ 0, 0, 0 }, texture_layers);
+  builder.Push({ second_array.GetData(), indices, Transform::Translate(0, 0, -1) });
+  builder.Push({ first_array.GetData(), indices, Transform::Translate(0, 0, -2) });
+  builder.Push({ second_array.GetData(), indices, Transform::Translate(0, 0, -3) });
+  builder.Push({ translucent_first.GetData(), indices, Transform::Translate(0, 0, -4), true });
+  builder.Push({ translucent_second.GetData(), indices, Transform::Translate(0, 0, -5), true });
+  builder.Push({ translucent_first.GetData(), indices, Transform::Translate(0, 0, -6), true });
+  const Batch batch = Build(builder);
+
+  // Opaque objects are grouped by array, while translucent ones keep their depth order
+  const std::vector<BatchBuilder::BatchRange>& ranges = builder.GetRanges();
+  ASSERT_EQ(ranges.size(), 5u);
+  const std::vector<std::tuple<u32, u64, u64>> expected_ranges{
+    { 0, 0, 3 }, { 1, 3, 6 }, { 0, 9, 3 }, { 1, 12, 3 }, { 0, 15, 3 }
+  };
+  for (u64 i = 0; i < ranges.size(); i++)
+  {
+    const auto& [texture_array, first_index, count] = ranges[i];
+    EXPECT_EQ(std::tuple(texture_array, first_index, count), expected_ranges[i]);
+  }
+
+  const std::vector<PackedVertexStruct>& vertices = batch.vertices;
+  EXPECT_FLOAT_EQ(vertices[3].position.z, -1);
+  EXPECT_FLOAT_EQ(vertices[6].position.z, -3);
+  EXPECT_FLOAT_EQ(vertices[9].position.z, -6);
+}
@@ -0,0 +1,42 @@
+#include "math/ge_transformations.hpp"
+#include "renderer/ge_buffer_handler.hpp"
+
+#include <gtest/gtest.h>
+
+#if defined(GE_CLANG_COMPILER)
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+
+using namespace GE;
+
+TEST(BufferHandler, UpdatePosition)
+{
+  // Enough vertices for full SIMD blocks and a scalar remainder
+  std::vector<VertexStruct> vertices;
+  for (u32 i = 0; i < 13; i++)
+  {
+    const auto fi = static_cast<f32>(i);
+    const Vec3 position{ fi, -fi, 0.5F * fi };
+    const Vec3 normal = Vec3{ 1, fi, -2 }.Normalize();
+    vertices.push_back({ position, Vec2{}, Vec4{ 1, 1, 1, 1 }, normal, 0 });
+  }
+
+  const Mat4 model = Transform::Translate(1, 2, 3) * Transform::Rotate(30, Vec3{ 1, 1, 0 }) *
+                     Transform::Scale(2, 0.5F, 3);
+  VerticesData vd{ vertices };
+  BufferHandler::UpdatePosition(vd, model);
+
+  const Mat3 normal_matrix = model.Inverse().Transpose().ToMat3();
+  for (u64 i = 0; i < vertices.size(); i++)
+  {
+    const Vec3 position = model * vertices[i].position;
+    const Vec3 normal = (normal_matrix * vertices[i].normal).Normalize();
+    const VertexStruct& res = vd.GetData()[i];
+    ASSERT_NEAR(res.position.x, position.x, 1e-4);
+    ASSERT_NEAR(res.position.y, position.y, 1e-4);
+    ASSERT_NEAR(res.position.z, position.z, 1e-4);
+    ASSERT_NEAR(res.normal.x, normal.x, 1e-5);
+    ASSERT_NEAR(res.normal.y, normal.y, 1e-5);
+    ASSERT_NEAR(res.normal.z, normal.z, 1e-5);
+  }
+}
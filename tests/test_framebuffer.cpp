@@ -0,0 +1,83 @@
+#include "core/ge_memory.hpp"
+#include "core/ge_window.hpp"
+#include "renderer/ge_framebuffer.hpp"
+#include "renderer/ge_render_target_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#if defined(GE_CLANG_COMPILER)
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+
+using namespace GE;
+
+TEST(RenderTargetPool, ReusesReleasedTargets)
+{
+  Scope<Window> window = MakeScope<Window>(WindowProps{ "Test", { 1, 1 }, {} }, nullptr);
+  EXPECT_NE(window, nullptr);
+
+  RenderTargetPool pool;
+  const RenderTargetSpec spec{ { 64, 64 }, AttachmentFormat::RGBA8, 1 };
+  const RendererID first = pool.Acquire(spec);
+  pool.Release(spec, first);
+  EXPECT_EQ(pool.Acquire(spec), first);
+  EXPECT_EQ(pool.TakeAllocationsCount(), 1u);
+
+  const RenderTargetSpec depth_spec{ { 64, 64 }, AttachmentFormat::DEPTH24_STENCIL8, 1 };
+  const RendererID depth = pool.Acquire(depth_spec);
+  EXPECT_NE(depth, first);
+  EXPECT_EQ(pool.TakeAllocationsCount(), 1u);
+
+  pool.Release(spec, first);
+  pool.Release(depth_spec, depth);
+  pool.Clear();
+  (void)pool.Acquire(spec);
+  EXPECT_EQ(pool.TakeAllocationsCount(), 1u);
+}
+
+TEST(Framebuffer, ResizesWithinAllocation)
+{
+  Scope<Window> window = MakeScope<Window>(WindowProps{ "Test", { 1, 1 }, {} }, nullptr);
+  EXPECT_NE(window, nullptr);
+
+  Framebuffer fb{ { 100, 100 } };
+  const RendererID color = fb.GetColorAttachmentID();
+  EXPECT_EQ(fb.GetAllocatedDimension(), (Dimensions{ 128, 128 }));
+
+  fb.Resize({ 120, 90 });
+  EXPECT_EQ(fb.GetDimension(), (Dimensions{ 120, 90 }));
+  EXPECT_EQ(fb.GetColorAttachmentID(), color);
+
+  fb.Resize({ 130, 90 });
+  EXPECT_EQ(fb.GetAllocatedDimension(), (Dimensions{ 192, 128 }));
+  EXPECT_NE(fb.GetColorAttachmentID(), color);
+
+  // Shrinking below half of the attachments reallocates them
+  fb.Resize({ 60, 60 });
+  EXPECT_EQ(fb.GetAllocatedDimension(), (Dimensions{ 64, 64 }));
+
+  // Going back reuses the attachments left in the pool
+  fb.Resize({ 120, 90 });
+  EXPECT_EQ(fb.GetAllocatedDimension(), (Dimensions{ 128, 128 }));
+  EXPECT_EQ(fb.GetColorAttachmentID(), color);
+
+  // The other attachments are deleted, instead of being left to the next tests
+  RenderTargetPool::Get().Clear();
+  (void)RenderTargetPool::Get().TakeAllocationsCount();
+}
+
+TEST(Framebuffer, FreesAttachmentsWhenDestroyed)
+{
+  Scope<Window> window = MakeScope<Window>(WindowProps{ "Test", { 1, 1 }, {} }, nullptr);
+  EXPECT_NE(window, nullptr);
+
+  (void)RenderTargetPool::Get().TakeAllocationsCount();
+  {
+    const Framebuffer fb{ { 64, 64 } };
+  }
+  EXPECT_EQ(RenderTargetPool::Get().TakeAllocationsCount(), 2u);
+
+  // Nothing was left in the pool to be reused
+  const Framebuffer fb{ { 64, 64 } };
+  EXPECT_EQ(RenderTargetPool::Get().TakeAllocationsCount(), 2u);
+}
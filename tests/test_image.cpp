@@ -0,0 +1,48 @@
+#include "renderer/ge_image.hpp"
+
+#include <gtest/gtest.h>
+
+#if defined(GE_CLANG_COMPILER)
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+
+using namespace GE;
+
+TEST(Image, MipLevels)
+{
+  EXPECT_EQ(Image::MipLevelsCount({ 1, 1 }), 1u);
+  EXPECT_EQ(Image::MipLevelsCount({ 256, 64 }), 9u);
+  EXPECT_EQ(Image::MipLevelsCount({ 300, 200 }), 9u);
+
+  EXPECT_EQ(Image::LevelDimension({ 256, 64 }, 7), (Dimensions{ 2, 1 }));
+  EXPECT_EQ(Image::LevelSize(PixelFormat::RGBA8, { 256, 64 }, 1), 128u * 32u * 4u);
+  EXPECT_EQ(Image::LevelSize(PixelFormat::BC1, { 256, 64 }, 0), 64u * 16u * 8u);
+  EXPECT_EQ(Image::LevelSize(PixelFormat::BC7, { 256, 64 }, 8), 16u);
+}
+
+TEST(Image, LoadsCompressedDDS)
+{
+  // Header of a 8x8 BC1 texture with 2 levels, followed by 4 blocks and 1 block
+  std::vector<u32> header(32, 0);
+  header[0] = 0x20534444;
+  header[1] = 124;
+  header[3] = 8;
+  header[4] = 8;
+  header[7] = 2;
+  header[21] = 0x31545844;
+  const std::vector<u8> blocks(5 * 8, 0xAB);
+
+  const auto path = std::filesystem::temp_directory_path() / "unit_test.dds";
+  {
+    std::ofstream file{ path, std::ios::binary };
+    file.write(reinterpret_cast<const char*>(header.data()), i64(header.size() * sizeof(u32)));
+    file.write(reinterpret_cast<const char*>(blocks.data()), i64(blocks.size()));
+  }
+
+  const Image image = Image::Load(path);
+  std::filesystem::remove(path);
+  EXPECT_EQ(image.format, PixelFormat::BC1);
+  EXPECT_EQ(image.dimension, (Dimensions{ 8, 8 }));
+  EXPECT_EQ(image.levels, 2u);
+  EXPECT_EQ(image.pixels, blocks);
+}
@@ -0,0 +1,60 @@
+#include "renderer/ge_image_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#if defined(GE_CLANG_COMPILER)
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+
+using namespace GE;
+
+namespace
+{
+  /**
+   * 2x1 bitmap of 24 bits with both pixels of the color
+   */
+  void WriteBitmap(const std::filesystem::path& path, u8 blue, u8 green, u8 red)
+  {
+    std::vector<u8> bmp{ 'B', 'M', 62, 0, 0, 0, 0, 0, 0, 0, 54, 0, 0, 0, // File header
+                         40,  0,   0,  0, 2, 0, 0, 0, 1, 0, 0,  0, 1, 0, // Info header
+                         24,  0,   0,  0, 0, 0, 8, 0, 0, 0, 0,  0, 0, 0,
+                         0,   0,   0,  0, 0, 0, 0, 0, 0, 0, 0,  0 };
+    bmp.insert(bmp.end(), { blue, green, red, blue, green, red, 0, 0 });
+    std::ofstream file{ path, std::ios::binary };
+    file.write(reinterpret_cast<const char*>(bmp.data()), i64(bmp.size()));
+  }
+
+  u64 CountFiles(const std::filesystem::path& directory)
+  {
+    return u64(std::distance(std::filesystem::directory_iterator{ directory },
+                             std::filesystem::directory_iterator{}));
+  }
+}
+
+TEST(ImageCache, StoresDecodedImages)
+{
+  const auto directory = std::filesystem::temp_directory_path() / "unit_test_image_cache";
+  const auto path = std::filesystem::temp_directory_path() / "unit_test.bmp";
+  std::filesystem::remove_all(directory);
+  const ImageCache cache{ directory };
+
+  WriteBitmap(path, 0x10, 0x20, 0x30);
+  const Image decoded = cache.Load(path);
+  ASSERT_EQ(decoded.dimension, (Dimensions{ 2, 1 }));
+  EXPECT_EQ(decoded.pixels, (std::vector<u8>{ 0x30, 0x20, 0x10, 0xFF, 0x30, 0x20, 0x10, 0xFF }));
+  EXPECT_EQ(CountFiles(directory), 1u);
+
+  const Image cached = cache.Load(path);
+  EXPECT_EQ(cached.dimension, decoded.dimension);
+  EXPECT_EQ(cached.pixels, decoded.pixels);
+  EXPECT_EQ(CountFiles(directory), 1u);
+
+  // A changed file is decoded again
+  WriteBitmap(path, 0x40, 0x50, 0x60);
+  const Image changed = cache.Load(path);
+  EXPECT_EQ(changed.pixels.front(), 0x60);
+  EXPECT_EQ(CountFiles(directory), 2u);
+
+  std::filesystem::remove(path);
+  std::filesystem::remove_all(directory);
+}
@@ -6,6 +6,25 @@
   #pragma clang diagnostic ignored "-Wglobal-constructors"
 #endif
 
+namespace
+{
+  class CountedScript : public GE::ScriptableEntity
+  {
+  public:
+    CountedScript(GE::Entity ent, GE::Scene& scene, int* alive) :
+        GE::ScriptableEntity(ent, scene), m_alive(alive)
+    {
+      (*m_alive)++;
+    }
+    CountedScript(const CountedScript&) = delete;
+    CountedScript& operator=(const CountedScript&) = delete;
+    ~CountedScript() override { (*m_alive)--; }
+
+  private:
+    int* m_alive;
+  };
+}
+
 TEST(Scene, CreateEntities)
 {
   GE::Ptr<GE::Scene> scene = GE::Scene::Make("TestScene");
@@ -31,3 +50,160 @@ TEST(Scene, AddComponents)
 
   ASSERT_EQ(scene->GetComponent<GE::TransformComponent>(second_ent).Position().x, GE::Vec3{}.x);
 }
+
+TEST(Scene, RemoveComponents)
+{
+  GE::Ptr<GE::Scene> scene = GE::Scene::Make("TestScene");
+  GE::Entity first_ent = scene->CreateEntity("First");
+  GE::Entity second_ent = scene->CreateEntity("Second");
+  scene->AddComponent<GE::TransformComponent>(first_ent, GE::Vec3{ 1, 0, 0 });
+  scene->AddComponent<GE::TransformComponent>(second_ent, GE::Vec3{ 2, 0, 0 });
+
+  scene->RemoveComponent<GE::TransformComponent>(first_ent);
+
+  ASSERT_FALSE(scene->HasComponent<GE::TransformComponent>(first_ent));
+  ASSERT_TRUE(scene->HasComponent<GE::TagComponent>(first_ent));
+  ASSERT_TRUE(scene->HasComponent<GE::TransformComponent>(second_ent));
+  ASSERT_EQ(scene->GetComponent<GE::TransformComponent>(second_ent).Position().x, 2);
+}
+
+TEST(Scene, DeferredCommands)
+{
+  GE::Ptr<GE::Scene> scene = GE::Scene::Make("TestScene");
+  GE::Entity first_ent = scene->CreateEntity("First");
+  scene->EnqueueToDestroy(first_ent);
+  scene->EnqueueToCreate("Second",
+                         [&](GE::Entity ent)
+                         { scene->AddComponent<GE::TransformComponent>(ent, GE::Vec3{ 1, 2, 3 }); });
+  ASSERT_TRUE(scene->HasComponent<GE::TagComponent>(first_ent));
+
+  std::vector<GE::Entity> entities;
+  scene->OnEachEntity([&](GE::Entity ent) { entities.push_back(ent); });
+  ASSERT_FALSE(scene->HasComponent<GE::TagComponent>(first_ent));
+  ASSERT_EQ(scene->GetEntities().size(), 1u);
+
+  // Commands already played must not run again
+  GE::Entity third_ent = scene->CreateEntity("Third");
+  scene->OnEachEntity([](GE::Entity) {});
+  ASSERT_TRUE(scene->HasComponent<GE::TagComponent>(third_ent));
+  ASSERT_EQ(scene->GetEntities().size(), 2u);
+}
+
+TEST(Scene, CreateEntitiesFromPrefab)
+{
+  GE::Ptr<GE::Scene> scene = GE::Scene::Make("TestScene");
+  GE::Entity prefab = scene->CreateEntity("Prefab");
+  scene->AddComponent<GE::TransformComponent>(prefab, GE::Vec3{ 1, 2, 3 });
+
+  std::vector<GE::Entity> entities = scene->CreateEntities(100, prefab);
+
+  ASSERT_EQ(entities.size(), 100u);
+  for (const GE::Entity& ent : entities)
+  {
+    ASSERT_NE(ent, prefab);
+    ASSERT_TRUE(scene->HasComponent<GE::TagComponent>(ent));
+    ASSERT_EQ(scene->GetComponent<GE::TransformComponent>(ent).Position().y, 2);
+  }
+}
+
+TEST(Scene, DestroyKeepsCreationOrder)
+{
+  GE::Ptr<GE::Scene> scene = GE::Scene::Make("TestScene");
+  GE::Entity first_ent = scene->CreateEntity("First");
+  GE::Entity second_ent = scene->CreateEntity("Second");
+  GE::Entity third_ent = scene->CreateEntity("Third");
+  scene->EnqueueToDestroy(second_ent);
+  scene->OnEachEntity([](GE::Entity) {});
+  scene->DisableEntity(third_ent);
+
+  std::vector<GE::Entity> entities;
+  scene->OnEachEntity([&](GE::Entity ent) { entities.push_back(ent); });
+
+  ASSERT_EQ(entities, (std::vector<GE::Entity>{ first_ent, third_ent }));
+  ASSERT_EQ(scene->GetEntities().size(), 2u);
+  ASSERT_FALSE(scene->HasComponent<GE::TagComponent>(third_ent));
+}
+
+TEST(Scene, ArchetypeStorage)
+{
+  GE::Ptr<GE::Scene> scene = GE::Scene::Make("TestScene", GE::StorageMode::ARCHETYPE);
+  GE::Entity first_ent = scene->CreateEntity("First");
+  GE::Entity second_ent = scene->CreateEntity("Second");
+  scene->AddComponent<GE::TransformComponent>(first_ent, GE::Vec3{ 1, 0, 0 });
+  scene->AddComponent<GE::TransformComponent>(second_ent, GE::Vec3{ 2, 0, 0 });
+  std::vector<GE::Entity> copies = scene->CreateEntities(10, second_ent);
+
+  scene->RemoveComponent<GE::TagComponent>(first_ent);
+  scene->EnqueueToDestroy(copies.front());
+  scene->OnEachEntity([](GE::Entity) {});
+
+  ASSERT_FALSE(scene->HasComponent<GE::TagComponent>(first_ent));
+  ASSERT_EQ(scene->GetComponent<GE::TransformComponent>(first_ent).Position().x, 1);
+  ASSERT_EQ(scene->GetComponent<GE::TagComponent>(second_ent).Tag(), "Second");
+  ASSERT_EQ(scene->GetComponent<GE::TransformComponent>(copies.back()).Position().x, 2);
+  ASSERT_EQ(scene->GetEntities().size(), 11u);
+}
+
+TEST(Scene, PushWhileIterating)
+{
+  GE::Ptr<GE::Scene> scene = GE::Scene::Make("TestScene");
+  GE::Entity first_ent = scene->CreateEntity("First");
+  GE::Entity second_ent = scene->CreateEntity("Second");
+  scene->EnqueueToDestroy(first_ent);
+  scene->OnEachEntity([](GE::Entity) {});
+
+  // The stale handle of the first slot is still in the creation order
+  const GE::Entity pushed = GE::Entity::Make(first_ent.Index(), first_ent.Generation() + 1);
+  std::vector<GE::Entity> entities;
+  scene->OnEachEntity(
+    [&](GE::Entity ent)
+    {
+      if (entities.empty())
+      {
+        ASSERT_EQ(scene->PushEntity(pushed), pushed);
+      }
+      entities.push_back(ent);
+    });
+
+  ASSERT_EQ(entities, (std::vector<GE::Entity>{ second_ent, pushed }));
+  ASSERT_EQ(scene->GetEntities().size(), 2u);
+}
+
+TEST(Scene, PushRemapsStaleGenerations)
+{
+  GE::Ptr<GE::Scene> scene = GE::Scene::Make("TestScene");
+  GE::Entity first_ent = scene->CreateEntity("First");
+  scene->EnqueueToDestroy(first_ent);
+  scene->OnEachEntity([](GE::Entity) {});
+
+  // Pushing an earlier life of the slot must not make its handle valid again
+  const GE::Entity remapped = scene->PushEntity(first_ent);
+  ASSERT_NE(remapped, first_ent);
+  ASSERT_FALSE(scene->HasComponent<GE::TagComponent>(first_ent));
+}
+
+TEST(Scene, NativeScriptOwnsItsInstance)
+{
+  GE::Ptr<GE::Scene> scene = GE::Scene::Make("TestScene");
+  const GE::Entity ent = scene->CreateEntity("Scripted");
+  int alive = 0;
+  {
+    GE::NativeScriptComponent script;
+    script.Bind<CountedScript>(&alive);
+    script.Instantiate(ent, *scene);
+    ASSERT_EQ(alive, 1);
+
+    // Moves transfer the instance, and copies get none
+    GE::NativeScriptComponent moved{ std::move(script) };
+    ASSERT_TRUE(moved.IsValid());
+    GE::NativeScriptComponent copy{ moved };
+    ASSERT_FALSE(copy.IsValid());
+    ASSERT_EQ(alive, 1);
+
+    copy.Instantiate(ent, *scene);
+    ASSERT_EQ(alive, 2);
+    copy = moved;
+    ASSERT_EQ(alive, 1);
+  }
+  ASSERT_EQ(alive, 0);
+}
@@ -32,7 +32,7 @@ TEST(SceneSerializer, Serialize)
                                                   GE::Vec3{ 1, 2, 3 },
                                                   5.5f,
                                                   true);
-  const std::set<GE::Entity>& entities = scene->GetEntitiesSet();
+  const std::vector<GE::Entity>& entities = scene->GetEntities();
   GE::SceneSerializer serializer{ scene };
   serializer.SerializeToFile(file_path);
 
@@ -47,7 +47,7 @@ TEST(SceneSerializer, Serialize)
   scene_2_read->OnEachEntity(
     [&](GE::Entity entity)
     {
-      ASSERT_TRUE(entities.contains(entity));
+      ASSERT_NE(std::ranges::find(entities, entity), entities.end());
 
       if (entity == full_ent)
       {
@@ -60,6 +60,35 @@ out vec4 fragColor;
 void main()
 {
     fragColor = out_color;
+})";
+    return s;
+  }
+
+  const std::string UNIFORMS_VSHADER()
+  {
+    static std::string s = R"(
+#version 330 core
+layout (location = 0) in vec3 in_position;
+uniform float u_scale;
+uniform int u_ids[3];
+flat out int out_id;
+void main()
+{
+    gl_Position = vec4(u_scale * in_position, 1.0f);
+    out_id = u_ids[0] + u_ids[1] + u_ids[2];
+})";
+    return s;
+  }
+
+  const std::string UNIFORMS_FSHADER()
+  {
+    static std::string s = R"(
+#version 330 core
+flat in int out_id;
+out vec4 fragColor;
+void main()
+{
+    fragColor = vec4(float(out_id), 0, 0, 1);
 })";
     return s;
   }
@@ -81,3 +110,44 @@ TEST(ShaderProgram, Shader)
   shader_program.Unbind();
   EXPECT_FALSE(shader_program.IsBound());
 }
+
+TEST(ShaderProgram, UploadsThroughResolvedLocations)
+{
+  using namespace GE;
+  Scope<Window> window = MakeScope<Window>(WindowProps{ "Test", { 1, 1 }, {} }, nullptr);
+  EXPECT_NE(window, nullptr);
+
+  Shader shader_program(UNIFORMS_VSHADER(), UNIFORMS_FSHADER());
+  ASSERT_TRUE(shader_program.IsValid());
+  shader_program.Bind();
+  EXPECT_TRUE(shader_program.IsBound());
+  (void)Shader::TakeUploadsCount();
+
+  // Arrays are found by their name without the "[0]" suffix reported by the program
+  shader_program.UploadFloat("u_scale", 2.0f);
+  shader_program.UploadIntArray("u_ids", { 1, 2, 3 });
+  EXPECT_EQ(Shader::TakeUploadsCount(), 2u);
+  EXPECT_EQ(Shader::TakeUploadsCount(), 0u);
+
+  ASSERT_DEATH({ shader_program.UploadIntArray("u_ids[0]", { 1 }); }, "");
+  ASSERT_DEATH({ shader_program.UploadFloat("u_unknown", 1.0f); }, "");
+}
+
+TEST(UniformName, HashedAtCompileTime)
+{
+  using namespace GE;
+  constexpr UniformName name = "u_VP";
+  static_assert(name.GetHash() == UniformName::Hash("u_VP"));
+
+  ASSERT_EQ(name.GetName(), "u_VP");
+  ASSERT_EQ(UniformName::Hash(""), 14695981039346656037ULL);
+  ASSERT_EQ(UniformName::Hash("a"), 0xAF63DC4C8601EC8CULL);
+}
+
+TEST(UniformName, DistinctNames)
+{
+  using namespace GE;
+  constexpr UniformName texture = "u_texture";
+  constexpr UniformName textures = "u_textures";
+  ASSERT_NE(texture.GetHash(), textures.GetHash());
+}
@@ -0,0 +1,67 @@
+#include "core/ge_memory.hpp"
+#include "core/ge_window.hpp"
+#include "renderer/ge_stream_buffer.hpp"
+
+#include <gtest/gtest.h>
+
+#if defined(GE_CLANG_COMPILER)
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+
+using namespace GE;
+
+TEST(StreamBuffer, RegionsInTurn)
+{
+  Scope<Window> window = MakeScope<Window>(WindowProps{ "Test", { 1, 1 }, {} }, nullptr);
+  EXPECT_NE(window, nullptr);
+
+  StreamBuffer stream{ sizeof(u32), 4 };
+  for (u32 frame = 0; frame < 2 * StreamBuffer::REGIONS_COUNT; frame++)
+  {
+    auto* data = static_cast<u32*>(stream.Append(4));
+    ASSERT_NE(data, nullptr);
+    std::ranges::fill(std::span{ data, 4 }, frame);
+    EXPECT_EQ(stream.GetFirstElement(), (frame % StreamBuffer::REGIONS_COUNT) * 4);
+    stream.EndFrame();
+  }
+}
+
+TEST(StreamBuffer, PassesShareTheRegionOfTheFrame)
+{
+  Scope<Window> window = MakeScope<Window>(WindowProps{ "Test", { 1, 1 }, {} }, nullptr);
+  EXPECT_NE(window, nullptr);
+
+  StreamBuffer stream{ sizeof(u32), 4 };
+  for (u32 frame = 0; frame < 2 * StreamBuffer::REGIONS_COUNT; frame++)
+  {
+    const u64 region_start = (frame % StreamBuffer::REGIONS_COUNT) * 4;
+    std::ranges::fill(std::span{ static_cast<u32*>(stream.Append(1)), 1 }, frame);
+    EXPECT_EQ(stream.GetFirstElement(), region_start);
+    std::ranges::fill(std::span{ static_cast<u32*>(stream.Append(3)), 3 }, frame);
+    EXPECT_EQ(stream.GetFirstElement(), region_start + 1);
+    stream.EndFrame();
+  }
+  EXPECT_EQ(stream.GetAllocationsCount(), 1u);
+}
+
+TEST(StreamBuffer, GrowsToFit)
+{
+  Scope<Window> window = MakeScope<Window>(WindowProps{ "Test", { 1, 1 }, {} }, nullptr);
+  EXPECT_NE(window, nullptr);
+
+  StreamBuffer stream{ sizeof(u32), 4 };
+  EXPECT_EQ(stream.GetAllocationsCount(), 1u);
+  auto* data = static_cast<u32*>(stream.Append(5));
+  std::ranges::fill(std::span{ data, 5 }, 1U);
+  EXPECT_EQ(stream.GetAllocationsCount(), 2u);
+
+  // The region grows to fit every pass of the frame
+  EXPECT_NE(stream.Append(4), nullptr);
+  EXPECT_EQ(stream.GetAllocationsCount(), 3u);
+  EXPECT_EQ(stream.GetFirstElement(), 0u);
+  stream.EndFrame();
+
+  EXPECT_NE(stream.Append(8), nullptr);
+  EXPECT_EQ(stream.GetFirstElement(), 16u);
+  stream.EndFrame();
+}
@@ -0,0 +1,26 @@
+#include "core/ge_memory.hpp"
+#include "core/ge_window.hpp"
+#include "scene/ge_textures_registry.hpp"
+
+#include <gtest/gtest.h>
+
+#if defined(GE_CLANG_COMPILER)
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+
+using namespace GE;
+
+TEST(TexturesRegistry, WhiteTextureAtFirstLayer)
+{
+  Scope<Window> window = MakeScope<Window>(WindowProps{ "Test", { 1, 1 }, {} }, nullptr);
+  EXPECT_NE(window, nullptr);
+
+  TexturesRegistry registry;
+  registry.LoadTextures();
+  ASSERT_TRUE(registry.Update());
+
+  const std::span<const i32> layers = registry.GetTextureLayers();
+  ASSERT_EQ(layers.size(), 1u);
+  EXPECT_EQ(layers[Texture2D::EMPTY_TEX_SLOT], 0);
+  EXPECT_FALSE(registry.Update());
+}
@@ -0,0 +1,52 @@
+#include "math/ge_arithmetic.hpp"
+#include "renderer/ge_vertices_data.hpp"
+
+#include <gtest/gtest.h>
+
+#if defined(GE_CLANG_COMPILER)
+  #pragma clang diagnostic ignored "-Wglobal-constructors"
+#endif
+
+using namespace GE;
+
+TEST(VerticesData, PackedLayout)
+{
+  ASSERT_EQ(sizeof(PackedVertexStruct), 28u);
+  ASSERT_EQ(VerticesData::GetLayout().GetStride(), sizeof(PackedVertexStruct));
+}
+
+TEST(VerticesData, Pack)
+{
+  const VertexStruct vs{ Vec3{ 1, 2, 3 },
+                         Vec2{ 0.25F, 0.75F },
+                         Vec4{ 1, 0.5F, 0, 1 },
+                         Vec3{ 0, -1, 1 }.Normalize(),
+                         7 };
+  const PackedVertexStruct packed = VerticesData::Pack(vs);
+
+  ASSERT_EQ(packed.position, vs.position);
+  ASSERT_EQ(Arithmetic::FromHalfFloat(packed.texture_coord[0]), 0.25F);
+  ASSERT_EQ(Arithmetic::FromHalfFloat(packed.texture_coord[1]), 0.75F);
+  ASSERT_EQ(packed.color, (std::array<u8, 4>{ 255, 128, 0, 255 }));
+  ASSERT_EQ(packed.texture_slot, 7);
+
+  // Sign extended components of the 10-10-10-2 normal
+  const auto component = [&](u32 shift)
+  {
+    const auto bits = static_cast<i32>((packed.normal >> shift) & 0x3FF);
+    return static_cast<f32>(bits >= 512 ? bits - 1024 : bits) / 511.0F;
+  };
+  ASSERT_NEAR(component(0), vs.normal.x, 1.0 / 511);
+  ASSERT_NEAR(component(10), vs.normal.y, 1.0 / 511);
+  ASSERT_NEAR(component(20), vs.normal.z, 1.0 / 511);
+}
+
+TEST(Arithmetic, HalfFloat)
+{
+  ASSERT_EQ(Arithmetic::ToHalfFloat(1.0F), 0x3C00);
+  ASSERT_EQ(Arithmetic::ToHalfFloat(-2.0F), 0xC000);
+  ASSERT_EQ(Arithmetic::ToHalfFloat(65504.0F), 0x7BFF);
+  ASSERT_EQ(Arithmetic::ToHalfFloat(1e6F), 0x7C00);
+  ASSERT_EQ(Arithmetic::ToHalfFloat(std::ldexp(1.0F, -24)), 0x0001);
+  ASSERT_EQ(Arithmetic::FromHalfFloat(Arithmetic::ToHalfFloat(0.1F)), 0.0999755859375F);
+}